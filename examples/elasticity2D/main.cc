@@ -1,10 +1,15 @@
 // Solve the equations of linear elasticity in 2D.
 
 #include "sfem.h"
+#include <filesystem>
 #include <iostream>
 using namespace sfem;
 
-void solve_elasticity(const std::string &mesh_path, Scalar E, Scalar nu, Scalar thick)
+void solve_elasticity(const std::string &mesh_path,
+                      const std::vector<std::string> &coarse_mesh_paths,
+                      Scalar E,
+                      Scalar nu,
+                      Scalar thick)
 {
     auto mesh = io::read_mesh(mesh_path);
     mesh.info();
@@ -27,12 +32,17 @@ void solve_elasticity(const std::string &mesh_path, Scalar E, Scalar nu, Scalar
     fe::constitutive::ThermoElasticPlaneConstitutive constitutive(prop, thick);
 
     // Create elements
-    std::vector<std::shared_ptr<fe::FiniteElement>> solid_elems;
-    for (const auto &cell : mesh.get_region_cells("Solid"))
+    auto create_solid_elems = [&](const mesh::Mesh &mesh)
     {
-        auto elem = std::make_unique<fe::solid::LinearElasticity2D>(cell, constitutive);
-        solid_elems.push_back(std::move(elem));
-    }
+        std::vector<std::shared_ptr<fe::FiniteElement>> elems;
+        for (const auto &cell : mesh.get_region_cells("Solid"))
+        {
+            auto elem = std::make_unique<fe::solid::LinearElasticity2D>(cell, constitutive);
+            elems.push_back(std::move(elem));
+        }
+        return elems;
+    };
+    auto solid_elems = create_solid_elems(mesh);
     std::vector<std::shared_ptr<fe::FiniteElement>> boundary_elems;
     for (const auto &cell : mesh.get_region_cells("Left"))
     {
@@ -45,19 +55,56 @@ void solve_elasticity(const std::string &mesh_path, Scalar E, Scalar nu, Scalar
     Logger::instance().info("Structural mass: " + std::to_string(mass.at(0, 0)) + "\n");
 
     auto K = la::petsc::create_mat(mesh, 2);
+    la::petsc::set_rigid_body_modes(K, disp); // Near null space, e.g. for -pc_type gamg
     auto F = la::petsc::create_vec(mesh, 2);
     auto U = la::petsc::create_vec(mesh, 2);
 
-    // Assemble system: K U = F
-    fe::assemble_matrix(solid_elems, disp, fe::FEMatrixType::stiffness, K);
-    fe::assemble_vector(solid_elems, disp, fe::FEVectorType::load, F);
-    fe::assemble_vector(boundary_elems, disp, fe::FEVectorType::load, F);
+    // Assemble system: K U = F, with the Dirichlet B.C. eliminated
+    fe::assemble_constrained_system(solid_elems, disp, fe::FEMatrixType::stiffness, fe::FEVectorType::load, K, F);
+    fe::assemble_constrained_vector(boundary_elems, disp, fe::FEVectorType::load, F);
 
-    // Remove Dirichlet B.C. and solve system
-    la::petsc::apply_fixed_dof(disp.get_fixed_dof(),
-                               disp.get_fixed_dof_values(),
-                               K, F, U);
-    la::petsc::solve(K, F, U);
+    // Coarse levels: the given coarse meshes (geometric multigrid), or the underlying linear mesh
+    // of a high order mesh (p-multigrid)
+    std::vector<mesh::Mesh> coarse_meshes;
+    for (const auto &path : coarse_mesh_paths)
+    {
+        coarse_meshes.push_back(io::read_mesh(path));
+    }
+    if (coarse_meshes.empty() && mesh.cells().size() > 0 && mesh.cells()[0].order() > 1)
+    {
+        coarse_meshes.push_back(mesh::create_linear_mesh(mesh));
+    }
+
+    // Solve system, using multigrid if coarse levels are available
+    if (coarse_meshes.empty())
+    {
+        la::petsc::solve(K, F, U);
+    }
+    else
+    {
+        // Coarse levels, rediscretised with the same elements and boundary conditions
+        std::vector<mesh::Field> fields;
+        std::vector<std::vector<std::shared_ptr<fe::FiniteElement>>> elems;
+        for (auto &coarse_mesh : coarse_meshes)
+        {
+            mesh::Field coarse_disp("U", 2, coarse_mesh, {"u", "v"});
+            coarse_disp.add_fixed_dof("Fixed", 0, 0);
+            coarse_disp.add_fixed_dof("Fixed", 1, 0);
+            fields.push_back(coarse_disp);
+            elems.push_back(create_solid_elems(coarse_mesh));
+        }
+        fields.push_back(disp);
+        elems.push_back(solid_elems);
+
+        solvers::GeometricMultigrid mg(elems, fields);
+        mg.set_rigid_body_modes(); // E.g. for -mg_coarse_pc_type gamg
+        la::petsc::PetscKSP solver;
+        mg.setup(solver);
+        solver.set_from_options();
+        solver.set_operator(K.mat());
+        int n_iter = solver.solve(F.vec(), U.vec());
+        Logger::instance().info("Multigrid iterations: " + std::to_string(n_iter) + "\n");
+    }
 
     // Update field values and write to file
     disp.set_values(U.get_values());
@@ -73,11 +120,18 @@ int main(int argc, char **argv)
     initialize(&argc, &argv, "ElasticitySolver2D");
 
     std::string mesh_path = argv[1];
+
+    // Optional coarse meshes of the same domain, from coarsest to finest, for geometric multigrid
+    std::vector<std::string> coarse_mesh_paths;
+    for (int i = 2; i < argc && std::filesystem::is_directory(argv[i]); i++)
+    {
+        coarse_mesh_paths.push_back(argv[i]);
+    }
     Scalar E = 5e9;
     Scalar nu = 0.35;
     Scalar thick = 1e-3;
 
-    solve_elasticity(mesh_path, E, nu, thick);
+    solve_elasticity(mesh_path, coarse_mesh_paths, E, nu, thick);
 
     finalize();
     return 0;
@@ -41,19 +41,15 @@ for cell in mesh.get_region_cells("Left"):
 
 # Create linear system matrix/vectors
 K = pysfem.la.petsc.create_mat(mesh, 2)
+pysfem.la.petsc.set_rigid_body_modes(K, disp)  # Near null space, e.g. for -pc_type gamg
 F = pysfem.la.petsc.create_vec(mesh, 2)
 U = pysfem.la.petsc.create_vec(mesh, 2)
 
-# Assemble system
-pysfem.fe.assemble_matrix(
-    solid_elems, disp, pysfem.fe.FEMatrixType.stiffness, K)
-pysfem.fe.assemble_vector(solid_elems, disp, pysfem.fe.FEVectorType.load, F)
-pysfem.fe.assemble_vector(boundary_elems, disp, pysfem.fe.FEVectorType.load, F)
-
-# Apply Dirichlet B.C. and solve
-pysfem.la.petsc.apply_fixed_dof(disp.get_fixed_dof(),
-                                disp.get_fixed_dof_values(),
-                                K, F, U)
+# Assemble system, with the Dirichlet B.C. eliminated, and solve
+pysfem.fe.assemble_constrained_system(
+    solid_elems, disp, pysfem.fe.FEMatrixType.stiffness, pysfem.fe.FEVectorType.load, K, F)
+pysfem.fe.assemble_constrained_vector(
+    boundary_elems, disp, pysfem.fe.FEVectorType.load, F)
 pysfem.la.petsc.solve(K, F, U)
 
 # Update field values
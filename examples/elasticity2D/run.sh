@@ -7,4 +7,10 @@ cmake -S . -B build
 (cd build; make)
 
 mpiexec -np 2 build/elasticitySolver2D mesh/mesh_quad2 -ksp_type cg 1e-8
+
+# Geometric multigrid, using the coarser meshes of the series
+mpiexec -np 2 build/elasticitySolver2D mesh/mesh_tri2 mesh/mesh_tri1 -ksp_type cg -ksp_monitor
+
+# Polynomial multigrid on a quadratic mesh, with algebraic multigrid on the linear level
+mpiexec -np 2 build/elasticitySolver2D mesh/mesh_quad3 -ksp_type cg -mg_coarse_pc_type gamg -ksp_monitor
 (cd fields; ${SFEM_DIR}/bin/sfemToVTK ../mesh/mesh_quad2 1 U stress)
\ No newline at end of file
@@ -39,17 +39,12 @@ void solve_elasticity(const std::string &mesh_path, Scalar rho, Scalar E, Scalar
 
     // Create linear system matrix/vectors
     auto K = la::petsc::create_mat(mesh, 3);
+    la::petsc::set_rigid_body_modes(K, disp); // Near null space, e.g. for -pc_type gamg
     auto F = la::petsc::create_vec(mesh, 3);
     auto U = la::petsc::create_vec(mesh, 3);
 
-    // Assemble system
-    fe::assemble_matrix(solid_elems, disp, fe::FEMatrixType::stiffness, K);
-    fe::assemble_vector(solid_elems, disp, fe::FEVectorType::load, F);
-
-    // Apply Dirichlet B.C. and solve
-    la::petsc::apply_fixed_dof(disp.get_fixed_dof(),
-                               disp.get_fixed_dof_values(),
-                               K, F, U);
+    // Assemble system, with the Dirichlet B.C. eliminated, and solve
+    fe::assemble_constrained_system(solid_elems, disp, fe::FEMatrixType::stiffness, fe::FEVectorType::load, K, F);
     la::petsc::solve(K, F, U);
 
     // Update field values
@@ -33,12 +33,7 @@ void solve_laplace(const std::string &mesh_path)
     auto U = la::petsc::create_vec(mesh, 1);
     auto F = la::petsc::create_vec(mesh, 1);
 
-    fe::assemble_matrix(elems, phi, fe::FEMatrixType::stiffness, K);
-    fe::assemble_vector(elems, phi, fe::FEVectorType::load, F);
-
-    la::petsc::apply_fixed_dof(phi.get_fixed_dof(),
-                               phi.get_fixed_dof_values(),
-                               K, F, U);
+    fe::assemble_constrained_system(elems, phi, fe::FEMatrixType::stiffness, fe::FEVectorType::load, K, F);
     la::petsc::solve(K, F, U);
 
     phi.set_values(U.get_values());
@@ -40,15 +40,9 @@ K = pysfem.la.petsc.create_mat(mesh, 1)
 F = pysfem.la.petsc.create_vec(mesh, 1)
 U = pysfem.la.petsc.create_vec(mesh, 1)
 
-# Assemble system
-pysfem.fe.assemble_matrix(
-    elems, phi, pysfem.fe.FEMatrixType.stiffness, K)
-pysfem.fe.assemble_vector(elems, phi, pysfem.fe.FEVectorType.load, F)
-
-# Apply Dirichlet B.C. and solve
-pysfem.la.petsc.apply_fixed_dof(phi.get_fixed_dof(),
-                                phi.get_fixed_dof_values(),
-                                K, F, U)
+# Assemble system, with the Dirichlet B.C. eliminated, and solve
+pysfem.fe.assemble_constrained_system(
+    elems, phi, pysfem.fe.FEMatrixType.stiffness, pysfem.fe.FEVectorType.load, K, F)
 pysfem.la.petsc.solve(K, F, U)
 
 # Update field values
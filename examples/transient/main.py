@@ -42,39 +42,16 @@ dt = 0.01
 # Number of time steps
 Nt = 100
 
-for i in range(Nt):
-    print(f"Time: {i * dt} [s]")
 
-    # Create linear system matrix/vectors
-    M = pysfem.la.petsc.create_mat(mesh, 1)
-    K = pysfem.la.petsc.create_mat(mesh, 1)
-    F = pysfem.la.petsc.create_vec(mesh, 1)
-    U = pysfem.la.petsc.create_vec(mesh, 1)
+def write_output(step, time, field):
+    print(f"Time: {time} [s]")
+    pysfem.io.write_field_values(f"fields/T_{step}", field, True)
+    # pysfem.io.write_vtk(f"fields/sfem_{step}.vtk", mesh, [field])
 
-    # Update/set the solution vector values from the field
-    U.insert_values(temp.get_local_dof(), temp.values())
 
-    # Assemble system
-    pysfem.fe.assemble_matrix(elems, temp, pysfem.fe.FEMatrixType.mass, M)
-    pysfem.fe.assemble_matrix(
-        elems, temp, pysfem.fe.FEMatrixType.stiffness, K)
-    pysfem.fe.assemble_vector(elems, temp, pysfem.fe.FEVectorType.load, F)
-
-    # Apply Dirichlet B.C. to system
-    pysfem.la.petsc.apply_fixed_dof(temp.get_fixed_dof(),
-                                    temp.get_fixed_dof_values(),
-                                    K, F, U)
-
-    # Implicit Euler timestepping
-    # (M/dt + K) U_new = M/dt U_old + F
-    pysfem.la.petsc.mat_scale(1/dt, M)
-    pysfem.la.petsc.mat_axpy(1, M, K)
-    pysfem.la.petsc.mat_mult_add(M, U, F, F)
-    pysfem.la.petsc.solve(K, F, U)
-
-    # Update field values
-    temp.set_values(U.get_values())
-
-    # Write to file
-    pysfem.io.write_field_values(f"fields/T_{i}", temp, True)
-    # pysfem.io.write_vtk(f"fields/sfem_{i}.vtk", mesh, [temp])
+# BDF2 time integration. The capacity (M) and conduction (K) matrices
+# are assembled once, and the effective operator is only formed when dt changes
+solver = pysfem.solvers.FirstOrderIntegrator(
+    elems, temp, pysfem.solvers.FirstOrderScheme.bdf2)
+solver.set_monitor(write_output)
+solver.solve(Nt * dt, dt)
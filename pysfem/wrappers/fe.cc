@@ -43,6 +43,12 @@ namespace sfem_wrappers
             .value("load", FEVectorType::load)
             .value("residual", FEVectorType::residual);
 
+        // MatrixLumping
+        nb::enum_<MatrixLumping>(m, "MatrixLumping")
+            .value("row_sum", MatrixLumping::row_sum)
+            .value("diagonal_scaling", MatrixLumping::diagonal_scaling)
+            .value("absolute_row_sum", MatrixLumping::absolute_row_sum);
+
         // FiniteElement
         nb::class_<FiniteElement>(m, "FiniteElement")
             .def(nb::init<const std::string &, int, int, mesh::Cell>())
@@ -97,7 +103,8 @@ namespace sfem_wrappers
             .def_rw("kappa", &ThermoMechanicalProperties::kappa, "Thermal conductivity")
             .def_rw("rho", &ThermoMechanicalProperties::rho, "Density")
             .def_rw("cp", &ThermoMechanicalProperties::cp, "Specific heat")
-            .def_rw("alpha", &ThermoMechanicalProperties::alpha, "Heat expansion coefficient");
+            .def_rw("alpha", &ThermoMechanicalProperties::alpha, "Heat expansion coefficient")
+            .def_rw("dkappa_dT", &ThermoMechanicalProperties::dkappa_dT, "Derivative of the thermal conductivity w.r.t. temperature");
 
         // ThermoElasticConstitutive
         nb::class_<ThermoElasticConstitutive>(m, "ThermoElasticConstitutive")
@@ -219,9 +226,23 @@ namespace sfem_wrappers
         // Assembly
         m.def("assemble_matrix", &assemble_matrix, "elems"_a, "field"_a, "type"_a, "mat"_a, "time"_a = 0.0);
         m.def("assemble_vector", &assemble_vector, "elems"_a, "field"_a, "type"_a, "vec"_a, "time"_a = 0.0);
+        m.def("assemble_constrained_system", &assemble_constrained_system, "elems"_a, "field"_a, "mat_type"_a, "vec_type"_a, "A"_a, "b"_a, "time"_a = 0.0, "diag"_a = 1.0);
+        m.def("assemble_constrained_matrix", &assemble_constrained_matrix, "elems"_a, "field"_a, "type"_a, "mat"_a, "time"_a = 0.0, "diag"_a = 1.0);
+        m.def("assemble_constrained_vector", &assemble_constrained_vector, "elems"_a, "field"_a, "type"_a, "vec"_a, "time"_a = 0.0);
+        m.def("assemble_block_vector", &assemble_block_vector, "load_cases"_a, "field"_a, "type"_a, "B"_a, "time"_a = 0.0);
+        m.def("assemble_constrained_block_vector", &assemble_constrained_block_vector, "load_cases"_a, "field"_a, "type"_a, "B"_a, "time"_a = 0.0);
+        m.def("assemble_vector_local", &assemble_vector_local, "elems"_a, "field"_a, "type"_a, "values"_a, "time"_a = 0.0);
+        m.def("assemble_lumped_matrix", &assemble_lumped_matrix, "elems"_a, "field"_a, "type"_a, "lumping"_a, "values"_a, "time"_a = 0.0);
+        m.def("assemble_matrix_action", &assemble_matrix_action, "elems"_a, "field"_a, "type"_a, "x"_a, "y"_a, "time"_a = 0.0);
         m.def("assemble_function", &assemble_function, "elems"_a, "field"_a, "func"_a, "time"_a = 0.0);
 
         // Project
         m.def("project_function", &project_function, "elems"_a, "field"_a, "func"_a, "time"_a = 0.0);
+        m.def("project_function_lumped", &project_function_lumped, "elems"_a, "field"_a, "func"_a, "time"_a = 0.0);
+        m.def("superconvergent_patch_recovery", &superconvergent_patch_recovery, "elems"_a, "field"_a, "func"_a, "time"_a = 0.0);
+        m.def("evaluate_cell_averages", &evaluate_cell_averages, "elems"_a, "field"_a, "func"_a, "time"_a = 0.0);
+
+        // Grid transfer
+        m.def("create_interpolation", &create_interpolation, "coarse_field"_a, "fine_field"_a);
     }
 }
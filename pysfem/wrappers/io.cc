@@ -12,14 +12,22 @@ namespace sfem_wrappers
     void init_io(nb::module_ &m)
     {
         // Mesh
-        m.def("read_mesh", &sfem::io::read_mesh, "dir"_a, "partitioner_type"_a = "METIS");
+        m.def("read_mesh", &sfem::io::read_mesh, "dir"_a, "partitioner_type"_a = "METIS", "ghost_cells"_a = false);
         m.def("write_mesh", &sfem::io::write_mesh);
 
         // Gmsh
         m.def("read_gmsh", &sfem::io::read_gmsh);
 
         // VTK
-        m.def("write_vtk", &sfem::io::write_vtk);
+        nb::class_<CellData>(m, "CellData")
+            .def(nb::init<>())
+            .def_rw("name", &CellData::name)
+            .def_rw("n_comps", &CellData::n_comps)
+            .def_rw("values", &CellData::values);
+        m.def("write_vtk", nb::overload_cast<const std::string &, const sfem::mesh::Mesh &, const std::vector<sfem::mesh::Field> &>(&sfem::io::write_vtk),
+              "path"_a, "mesh"_a, "fields"_a);
+        m.def("write_vtk", nb::overload_cast<const std::string &, const sfem::mesh::Mesh &, const std::vector<sfem::mesh::Field> &, const std::vector<CellData> &>(&sfem::io::write_vtk),
+              "path"_a, "mesh"_a, "fields"_a, "cell_data"_a);
 
         // Field
         m.def("read_field_values", &sfem::io::read_field_values);
@@ -4,6 +4,7 @@
 
 using namespace sfem::la;
 namespace nb = nanobind;
+using namespace nb::literals;
 
 namespace sfem_wrappers
 {
@@ -53,35 +54,63 @@ namespace sfem_wrappers
             .def("add_values", &PetscVec::add_values)
             .def("insert_values", &PetscVec::insert_values)
             .def("assemble", &PetscVec::assemble)
+            .def("assemble_begin", &PetscVec::assemble_begin)
+            .def("assemble_end", &PetscVec::assemble_end)
             .def("get_values", &PetscVec::get_values);
 
         // PetscMat
         nb::class_<PetscMat>(m, "PetscMat")
             .def(nb::init<const std::vector<int> &,
-                          const std::vector<int> &>())
+                          const std::vector<int> &,
+                          int>(),
+                 "diag_nnz"_a, "off_diag_nnz"_a, "block_size"_a = 1)
             .def("size_local", &PetscMat::size_local)
             .def("size_global", &PetscMat::size_global)
             .def("reset", &PetscMat::reset)
-            .def("local_values", &PetscMat::add_values)
-            .def("assemble", &PetscMat::assemble);
+            .def("add_values", nb::overload_cast<const std::vector<int> &, const std::vector<Scalar> &>(&PetscMat::add_values))
+            .def("add_values", nb::overload_cast<const std::vector<int> &, const std::vector<int> &, const std::vector<Scalar> &>(&PetscMat::add_values))
+            .def("assemble", &PetscMat::assemble)
+            .def("assemble_begin", [](PetscMat &mat)
+                 { mat.assemble_begin(); })
+            .def("assemble_end", [](PetscMat &mat)
+                 { mat.assemble_end(); });
 
         // PETSc utils
         m.def("create_vec", &create_vec);
         m.def("create_mat", &create_mat);
+        m.def("set_rigid_body_modes", &set_rigid_body_modes, "A"_a, "field"_a);
+        m.def("create_dense_mat", &create_dense_mat);
+        m.def("get_column", &get_column);
         m.def("vec_scale", &vec_scale);
+        m.def("vec_copy", &vec_copy);
+        m.def("vec_axpy", &vec_axpy);
+        m.def("vec_axpby", &vec_axpby);
+        m.def("mat_mult", &mat_mult);
         m.def("mat_mult_add", &mat_mult_add);
         m.def("mat_scale", &mat_scale);
         m.def("mat_axpy", &mat_axpy);
+        m.def("mat_copy", &mat_copy);
+        m.def("field_to_vec", &field_to_vec);
+        m.def("vec_to_field", &vec_to_field);
         m.def("apply_fixed_dof", &apply_fixed_dof);
-        m.def("solve", &solve);
+        m.def("solve", nb::overload_cast<const PetscMat &, const PetscVec &, PetscVec &>(&solve));
+        m.def("solve", nb::overload_cast<const PetscMat &, const PetscMat &, PetscMat &>(&solve));
 
-        // // PetscKSP
-        // nb::class_<PetscKSP>(m, "PetscKSP")
-        //     .def(nb::init<>())
-        //     .def("set_from_options", &PetscKSP::SetFromOptions)
-        //     .def("set_options_prefix", &PetscKSP::SetOptionsPrefix)
-        //     .def("set_operators", &PetscKSP::SetOperators)
-        //     .def("solve", &PetscKSP::Solve);
+        // PetscKSP
+        nb::class_<PetscKSP>(m, "PetscKSP")
+            .def(nb::init<>())
+            .def("set_from_options", &PetscKSP::set_from_options)
+            .def("set_options_prefix", &PetscKSP::set_options_prefix)
+            .def("set_operator", [](PetscKSP &ksp, const PetscMat &A)
+                 { ksp.set_operator(A.mat()); })
+            .def("set_tolerances", &PetscKSP::set_tolerances)
+            .def("set_reuse_preconditioner", &PetscKSP::set_reuse_preconditioner)
+            .def("is_operator_modified", &PetscKSP::is_operator_modified)
+            .def("n_setups", &PetscKSP::n_setups)
+            .def("solve", [](PetscKSP &ksp, const PetscVec &b, PetscVec &x)
+                 { return ksp.solve(b.vec(), x.vec()); })
+            .def("mat_solve", [](PetscKSP &ksp, const PetscMat &B, PetscMat &X)
+                 { return ksp.mat_solve(B.mat(), X.mat()); });
 
         // // SlepcEPS
         // nb::class_<SlepcEPS>(m, "SlepcEPS")
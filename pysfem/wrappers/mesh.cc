@@ -1,6 +1,8 @@
 #include "sfem.h"
 #include <nanobind/nanobind.h>
 #include <nanobind/stl/string.h>
+#include <nanobind/stl/pair.h>
+#include <nanobind/stl/vector.h>
 
 using namespace sfem::mesh;
 using namespace sfem::common;
@@ -75,9 +77,16 @@ namespace sfem_wrappers
             .def("get_region_by_name", &Mesh::get_region_by_name)
             .def("get_region_cells", &Mesh::get_region_cells)
             .def("get_region_nodes", &Mesh::get_region_nodes)
+            .def("has_ghost_cells", &Mesh::has_ghost_cells)
+            .def("is_cell_owned", &Mesh::is_cell_owned)
             .def("get_cell_nodes", &Mesh::get_cell_nodes)
             .def("get_cell_xpts", &Mesh::get_cell_xpts);
 
+        // Refinement
+        m.def("refine_uniform", &refine_uniform);
+        m.def("create_refinement_hierarchy", &create_refinement_hierarchy);
+        m.def("create_linear_mesh", &create_linear_mesh);
+
         // Field
         nb::class_<Field>(m, "Field")
             .def(nb::init<const std::string &,
@@ -98,13 +107,17 @@ namespace sfem_wrappers
             .def("get_ghost_dof", &Field::get_ghost_dof)
             .def("get_local_dof", &Field::get_local_dof)
             .def("get_cell_dof", &Field::get_cell_dof)
+            .def("get_cell_owned_dof", &Field::get_cell_owned_dof)
             .def("get_cell_values", &Field::get_cell_values)
             .def("add_fixed_dof", &Field::add_fixed_dof)
             .def("get_fixed_dof", &Field::get_fixed_dof)
             .def("get_fixed_dof_values", &Field::get_fixed_dof_values)
+            .def("get_local_fixed_dof", &Field::get_local_fixed_dof)
             .def("clear_fixed_dof", &Field::clear_fixed_dof)
             .def("set_all", &Field::set_all)
             .def("set_values", &Field::set_values)
-            .def("values", &Field::values, nb::rv_policy::reference_internal);
+            .def("values", nb::overload_cast<>(&Field::values, nb::const_), nb::rv_policy::reference_internal)
+            .def("update_ghosts", &Field::update_ghosts)
+            .def("accumulate_ghosts", &Field::accumulate_ghosts);
     }
 }
\ No newline at end of file
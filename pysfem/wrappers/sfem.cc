@@ -14,6 +14,7 @@ namespace sfem_wrappers
     void init_io(nb::module_ &m);
     void init_la(nb::module_ &m);
     void init_fe(nb::module_ &m);
+    void init_solvers(nb::module_ &m);
 };
 
 NB_MODULE(pysfem, m)
@@ -52,4 +53,8 @@ NB_MODULE(pysfem, m)
     // FE
     nb::module_ fe = m.def_submodule("fe", "FEM");
     sfem_wrappers::init_fe(fe);
+
+    // Solvers
+    nb::module_ solvers = m.def_submodule("solvers", "Time integration");
+    sfem_wrappers::init_solvers(solvers);
 }
\ No newline at end of file
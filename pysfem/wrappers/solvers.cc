@@ -0,0 +1,207 @@
+#include "sfem.h"
+#include <nanobind/nanobind.h>
+#include <nanobind/stl/shared_ptr.h>
+#include <nanobind/stl/vector.h>
+
+using namespace sfem;
+using namespace solvers;
+namespace nb = nanobind;
+using namespace nb::literals;
+
+namespace sfem_wrappers
+{
+    void init_solvers(nb::module_ &m)
+    {
+        // TimeIntegrator
+        nb::class_<TimeIntegrator>(m, "TimeIntegrator")
+            .def("time", &TimeIntegrator::time)
+            .def("n_steps", &TimeIntegrator::n_steps)
+            .def("n_operator_updates", &TimeIntegrator::n_operator_updates)
+            .def("field", &TimeIntegrator::field, nb::rv_policy::reference)
+            .def("ksp", &TimeIntegrator::ksp, nb::rv_policy::reference_internal)
+            // The load vector and the field are passed to the Python callbacks by reference, since the
+            // callbacks must modify the integrator's load vector, and the field should not be copied
+            .def("set_load_callback", [](TimeIntegrator &integrator, nb::callable callback)
+                 { integrator.set_load_callback([callback](Scalar time, la::petsc::PetscVec &F)
+                                                { callback(time, nb::cast(&F, nb::rv_policy::reference)); }); })
+            .def("set_monitor", [](TimeIntegrator &integrator, nb::callable callback)
+                 { integrator.set_monitor([callback](int step, Scalar time, const mesh::Field &field)
+                                          { callback(step, time, nb::cast(&field, nb::rv_policy::reference)); }); })
+            .def("update_fixed_dof", &TimeIntegrator::update_fixed_dof)
+            .def("order", &TimeIntegrator::order)
+            .def("advance", &TimeIntegrator::advance)
+            .def("take_step", &TimeIntegrator::take_step)
+            .def("estimate_error", &TimeIntegrator::estimate_error)
+            .def("save_state", &TimeIntegrator::save_state)
+            .def("restore_state", &TimeIntegrator::restore_state)
+            .def("notify_monitor", &TimeIntegrator::notify_monitor)
+            .def("solve", &TimeIntegrator::solve);
+
+        // FirstOrderScheme
+        nb::enum_<FirstOrderScheme>(m, "FirstOrderScheme")
+            .value("implicit_euler", FirstOrderScheme::implicit_euler)
+            .value("crank_nicolson", FirstOrderScheme::crank_nicolson)
+            .value("bdf2", FirstOrderScheme::bdf2);
+
+        // FirstOrderIntegrator
+        nb::class_<FirstOrderIntegrator, TimeIntegrator>(m, "FirstOrderIntegrator")
+            .def(nb::init<const std::vector<std::shared_ptr<fe::FiniteElement>> &,
+                          mesh::Field &,
+                          FirstOrderScheme,
+                          Scalar>(),
+                 "elems"_a, "field"_a, "scheme"_a = FirstOrderScheme::bdf2, "time"_a = 0.0,
+                 nb::keep_alive<1, 3>())
+            .def("scheme", &FirstOrderIntegrator::scheme);
+
+        // SecondOrderScheme
+        nb::enum_<SecondOrderScheme>(m, "SecondOrderScheme")
+            .value("newmark", SecondOrderScheme::newmark)
+            .value("generalized_alpha", SecondOrderScheme::generalized_alpha);
+
+        // SecondOrderIntegrator
+        nb::class_<SecondOrderIntegrator, TimeIntegrator>(m, "SecondOrderIntegrator")
+            .def(nb::init<const std::vector<std::shared_ptr<fe::FiniteElement>> &,
+                          mesh::Field &,
+                          SecondOrderScheme,
+                          Scalar>(),
+                 "elems"_a, "field"_a, "scheme"_a = SecondOrderScheme::newmark, "time"_a = 0.0,
+                 nb::keep_alive<1, 3>())
+            .def("scheme", &SecondOrderIntegrator::scheme)
+            .def("set_newmark_parameters", &SecondOrderIntegrator::set_newmark_parameters)
+            .def("set_spectral_radius", &SecondOrderIntegrator::set_spectral_radius)
+            .def("add_rayleigh_damping", &SecondOrderIntegrator::add_rayleigh_damping)
+            .def("set_initial_velocity", &SecondOrderIntegrator::set_initial_velocity)
+            .def("velocity", &SecondOrderIntegrator::velocity, nb::rv_policy::reference_internal)
+            .def("acceleration", &SecondOrderIntegrator::acceleration, nb::rv_policy::reference_internal);
+
+        // AdaptiveTimeStepper
+        nb::class_<AdaptiveTimeStepper>(m, "AdaptiveTimeStepper")
+            .def(nb::init<TimeIntegrator &, Scalar, Scalar>(),
+                 "integrator"_a, "rtol"_a = 1e-3, "atol"_a = 1e-6,
+                 nb::keep_alive<1, 2>())
+            .def("integrator", &AdaptiveTimeStepper::integrator, nb::rv_policy::reference)
+            .def("set_dt_limits", &AdaptiveTimeStepper::set_dt_limits)
+            .def("set_factor_limits", &AdaptiveTimeStepper::set_factor_limits)
+            .def("set_safety_factor", &AdaptiveTimeStepper::set_safety_factor)
+            .def("set_growth_threshold", &AdaptiveTimeStepper::set_growth_threshold)
+            .def("set_steady_state_tolerance", &AdaptiveTimeStepper::set_steady_state_tolerance)
+            .def("set_dt", &AdaptiveTimeStepper::set_dt)
+            .def("dt", &AdaptiveTimeStepper::dt)
+            .def("n_accepted", &AdaptiveTimeStepper::n_accepted)
+            .def("n_rejected", &AdaptiveTimeStepper::n_rejected)
+            .def("error_norm", &AdaptiveTimeStepper::error_norm)
+            .def("rate_of_change", &AdaptiveTimeStepper::rate_of_change)
+            .def("is_steady", &AdaptiveTimeStepper::is_steady)
+            .def("step", &AdaptiveTimeStepper::step)
+            .def("solve", &AdaptiveTimeStepper::solve);
+
+        // ExplicitIntegrator
+        nb::class_<ExplicitIntegrator>(m, "ExplicitIntegrator")
+            .def("time", &ExplicitIntegrator::time)
+            .def("n_steps", &ExplicitIntegrator::n_steps)
+            .def("field", &ExplicitIntegrator::field, nb::rv_policy::reference)
+            .def("lumped_mass", &ExplicitIntegrator::lumped_mass)
+            // The forces are passed to the Python callback by reference, since the callback must modify them
+            .def("set_load_callback", [](ExplicitIntegrator &integrator, nb::callable callback)
+                 { integrator.set_load_callback([callback](Scalar time, std::vector<Scalar> &F)
+                                                { callback(time, nb::cast(&F, nb::rv_policy::reference)); }); })
+            .def("set_monitor", [](ExplicitIntegrator &integrator, nb::callable callback)
+                 { integrator.set_monitor([callback](int step, Scalar time, const mesh::Field &field)
+                                          { callback(step, time, nb::cast(&field, nb::rv_policy::reference)); }); })
+            .def("update_fixed_dof", &ExplicitIntegrator::update_fixed_dof)
+            .def("order", &ExplicitIntegrator::order)
+            .def("stable_dt", &ExplicitIntegrator::stable_dt)
+            .def("set_safety_factor", &ExplicitIntegrator::set_safety_factor)
+            .def("advance", &ExplicitIntegrator::advance)
+            .def("take_step", &ExplicitIntegrator::take_step)
+            .def("notify_monitor", &ExplicitIntegrator::notify_monitor)
+            .def("solve", &ExplicitIntegrator::solve, "t_end"_a, "dt"_a = 0.0);
+
+        // CentralDifferenceIntegrator
+        nb::class_<CentralDifferenceIntegrator, ExplicitIntegrator>(m, "CentralDifferenceIntegrator")
+            .def(nb::init<const std::vector<std::shared_ptr<fe::FiniteElement>> &,
+                          mesh::Field &,
+                          fe::MatrixLumping,
+                          Scalar>(),
+                 "elems"_a, "field"_a, "lumping"_a = fe::MatrixLumping::diagonal_scaling, "time"_a = 0.0,
+                 nb::keep_alive<1, 3>())
+            .def("add_damping", &CentralDifferenceIntegrator::add_damping, "a"_a, "include_elements"_a = false)
+            .def("set_initial_velocity", &CentralDifferenceIntegrator::set_initial_velocity)
+            .def("velocity", &CentralDifferenceIntegrator::velocity)
+            .def("acceleration", &CentralDifferenceIntegrator::acceleration);
+
+        // RungeKuttaScheme
+        nb::enum_<RungeKuttaScheme>(m, "RungeKuttaScheme")
+            .value("forward_euler", RungeKuttaScheme::forward_euler)
+            .value("heun", RungeKuttaScheme::heun)
+            .value("ssp_rk3", RungeKuttaScheme::ssp_rk3)
+            .value("rk4", RungeKuttaScheme::rk4);
+
+        // RungeKuttaIntegrator
+        nb::class_<RungeKuttaIntegrator, ExplicitIntegrator>(m, "RungeKuttaIntegrator")
+            .def(nb::init<const std::vector<std::shared_ptr<fe::FiniteElement>> &,
+                          mesh::Field &,
+                          RungeKuttaScheme,
+                          fe::MatrixLumping,
+                          Scalar>(),
+                 "elems"_a, "field"_a, "scheme"_a = RungeKuttaScheme::ssp_rk3,
+                 "lumping"_a = fe::MatrixLumping::diagonal_scaling, "time"_a = 0.0,
+                 nb::keep_alive<1, 3>())
+            .def("scheme", &RungeKuttaIntegrator::scheme)
+            .def("n_stages", &RungeKuttaIntegrator::n_stages);
+
+        // NewtonSolver
+        nb::class_<NewtonSolver>(m, "NewtonSolver")
+            .def(nb::init<const std::vector<std::shared_ptr<fe::FiniteElement>> &, mesh::Field &, Scalar>(),
+                 "elems"_a, "field"_a, "time"_a = 0,
+                 nb::keep_alive<1, 3>())
+            .def("field", &NewtonSolver::field, nb::rv_policy::reference)
+            .def("set_time", &NewtonSolver::set_time)
+            .def("time", &NewtonSolver::time)
+            .def("set_options_prefix", &NewtonSolver::set_options_prefix)
+            .def("set_from_options", &NewtonSolver::set_from_options)
+            .def("set_tolerances", &NewtonSolver::set_tolerances, "rtol"_a, "atol"_a, "stol"_a, "max_iter"_a)
+            .def("set_lag_jacobian", &NewtonSolver::set_lag_jacobian, "lag"_a, "persists"_a = false)
+            .def("set_lag_preconditioner", &NewtonSolver::set_lag_preconditioner, "lag"_a, "persists"_a = false)
+            .def("set_eisenstat_walker", &NewtonSolver::set_eisenstat_walker)
+            .def("set_line_search", &NewtonSolver::set_line_search)
+            .def("update_fixed_dof", &NewtonSolver::update_fixed_dof)
+            .def("solve", &NewtonSolver::solve)
+            .def("converged", &NewtonSolver::converged)
+            .def("n_jacobian_evaluations", &NewtonSolver::n_jacobian_evaluations)
+            .def("n_residual_evaluations", &NewtonSolver::n_residual_evaluations);
+
+        // GeometricMultigrid
+        nb::class_<GeometricMultigrid>(m, "GeometricMultigrid")
+            .def(nb::init<const std::vector<std::vector<std::shared_ptr<fe::FiniteElement>>> &,
+                          const std::vector<mesh::Field> &,
+                          fe::FEMatrixType,
+                          Scalar>(),
+                 "elems"_a, "fields"_a, "type"_a = fe::FEMatrixType::stiffness, "time"_a = 0.0,
+                 nb::keep_alive<1, 3>())
+            .def(nb::init<const std::vector<mesh::Field> &, const la::petsc::PetscMat &>(),
+                 "fields"_a, "A"_a, nb::keep_alive<1, 2>())
+            .def("n_levels", &GeometricMultigrid::n_levels)
+            .def("interpolation", &GeometricMultigrid::interpolation, nb::rv_policy::reference_internal)
+            .def("coarse_operator", &GeometricMultigrid::coarse_operator, nb::rv_policy::reference_internal)
+            .def("assemble_operators", &GeometricMultigrid::assemble_operators, "time"_a = 0.0)
+            .def("project_operators", &GeometricMultigrid::project_operators)
+            .def("set_rigid_body_modes", &GeometricMultigrid::set_rigid_body_modes)
+            .def("setup", &GeometricMultigrid::setup);
+
+        // StaticCondensation
+        nb::class_<StaticCondensation>(m, "StaticCondensation")
+            .def(nb::init<const std::vector<std::shared_ptr<fe::FiniteElement>> &, const mesh::Field &>(),
+                 "elems"_a, "field"_a, nb::keep_alive<1, 3>())
+            .def("skeleton_im", &StaticCondensation::skeleton_im, nb::rv_policy::reference_internal)
+            .def("skeleton_nodes", &StaticCondensation::skeleton_nodes, nb::rv_policy::reference_internal)
+            .def("n_dof_skeleton_global", &StaticCondensation::n_dof_skeleton_global)
+            .def("create_mat", &StaticCondensation::create_mat)
+            .def("create_vec", &StaticCondensation::create_vec)
+            .def("assemble_system", &StaticCondensation::assemble_system,
+                 "mat_type"_a, "vec_type"_a, "A"_a, "b"_a, "time"_a = 0.0, "diag"_a = 1.0)
+            .def("assemble_vector", &StaticCondensation::assemble_vector,
+                 "elems"_a, "type"_a, "b"_a, "time"_a = 0.0)
+            .def("recover", &StaticCondensation::recover);
+    }
+}
\ No newline at end of file
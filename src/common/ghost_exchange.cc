@@ -0,0 +1,228 @@
+#include "ghost_exchange.h"
+#include "logger.h"
+#include "error.h"
+#include "mpi_utils.h"
+#include <algorithm>
+
+namespace sfem::common
+{
+    //=============================================================================
+    GhostExchange::GhostExchange(const IndexMap &im, int block_size)
+        : block_size_(block_size),
+          n_local_(im.n_local())
+    {
+        if (block_size <= 0)
+        {
+            Logger::instance().error("GhostExchange: Invalid block size: " + std::to_string(block_size) + "\n",
+                                     __FILE__, __LINE__);
+        }
+
+        int n_procs = Logger::instance().n_procs();
+        int n_owned = im.n_owned();
+        auto ghost_idxs = im.get_ghost_idxs();
+        auto ghost_owners = im.get_ghost_owners();
+
+        // Group the ghosts by owning process
+        std::vector<int> ghost_counts(n_procs, 0);
+        for (auto owner : ghost_owners)
+        {
+            ghost_counts[owner]++;
+        }
+        std::vector<int> displs(n_procs, 0);
+        ghost_ptr_.push_back(0);
+        for (int i = 0; i < n_procs; i++)
+        {
+            displs[i] = ghost_ptr_.back();
+            if (ghost_counts[i] > 0)
+            {
+                src_ranks_.push_back(i);
+                ghost_ptr_.push_back(ghost_ptr_.back() + ghost_counts[i]);
+            }
+        }
+        ghost_idxs_.resize(ghost_idxs.size());
+        std::vector<int> request_idxs(ghost_idxs.size());
+        for (std::size_t i = 0; i < ghost_idxs.size(); i++)
+        {
+            int pos = displs[ghost_owners[i]]++;
+            ghost_idxs_[pos] = n_owned + static_cast<int>(i);
+            request_idxs[pos] = ghost_idxs[i];
+        }
+
+        // Request the ghosts from their owners
+        shared_idxs_ = mpi::sparse_exchange(src_ranks_, ghost_ptr_, request_idxs,
+                                            dest_ranks_, shared_ptr_);
+
+        // Map the requested indices to local indexing
+        for (auto &idx : shared_idxs_)
+        {
+            int global_idx = idx;
+            idx = im.global_to_local(global_idx);
+            if (idx < 0 || idx >= n_owned)
+            {
+                Logger::instance().error("GhostExchange: Index " + std::to_string(global_idx) + " is not owned by this process\n",
+                                         __FILE__, __LINE__);
+            }
+        }
+
+        // Allocate the buffers. These must not be resized hereafter,
+        // since the persistent requests refer to their memory
+        ghost_buffer_.resize(ghost_idxs_.size() * block_size_);
+        shared_buffer_.resize(shared_idxs_.size() * block_size_);
+
+        // Create the persistent requests, on a private communicator so that their
+        // messages never match those of other exchanges that are in flight at the same time
+        MPI_Comm_dup(SFEM_COMM_WORLD, &comm_);
+        const int forward_tag = 0;
+        const int reverse_tag = 1;
+        for (std::size_t i = 0; i < src_ranks_.size(); i++)
+        {
+            int count = (ghost_ptr_[i + 1] - ghost_ptr_[i]) * block_size_;
+            Scalar *buffer = ghost_buffer_.data() + ghost_ptr_[i] * block_size_;
+            MPI_Request request;
+            MPI_Recv_init(buffer, count, SFEM_MPI_FLOAT, src_ranks_[i], forward_tag, comm_, &request);
+            forward_requests_.push_back(request);
+            MPI_Send_init(buffer, count, SFEM_MPI_FLOAT, src_ranks_[i], reverse_tag, comm_, &request);
+            reverse_requests_.push_back(request);
+        }
+        for (std::size_t i = 0; i < dest_ranks_.size(); i++)
+        {
+            int count = (shared_ptr_[i + 1] - shared_ptr_[i]) * block_size_;
+            Scalar *buffer = shared_buffer_.data() + shared_ptr_[i] * block_size_;
+            MPI_Request request;
+            MPI_Send_init(buffer, count, SFEM_MPI_FLOAT, dest_ranks_[i], forward_tag, comm_, &request);
+            forward_requests_.push_back(request);
+            MPI_Recv_init(buffer, count, SFEM_MPI_FLOAT, dest_ranks_[i], reverse_tag, comm_, &request);
+            reverse_requests_.push_back(request);
+        }
+    }
+    //=============================================================================
+    GhostExchange::~GhostExchange()
+    {
+        // Requests can not be freed after MPI has been finalized
+        int finalized;
+        MPI_Finalized(&finalized);
+        if (finalized)
+        {
+            return;
+        }
+
+        for (auto &request : forward_requests_)
+        {
+            MPI_Request_free(&request);
+        }
+        for (auto &request : reverse_requests_)
+        {
+            MPI_Request_free(&request);
+        }
+        MPI_Comm_free(&comm_);
+    }
+    //=============================================================================
+    int GhostExchange::block_size() const
+    {
+        return block_size_;
+    }
+    //=============================================================================
+    int GhostExchange::n_local() const
+    {
+        return n_local_;
+    }
+    //=============================================================================
+    std::vector<int> GhostExchange::neighbours() const
+    {
+        std::vector<int> ranks(src_ranks_);
+        ranks.insert(ranks.end(), dest_ranks_.begin(), dest_ranks_.end());
+        std::sort(ranks.begin(), ranks.end());
+        ranks.erase(std::unique(ranks.begin(), ranks.end()), ranks.end());
+        return ranks;
+    }
+    //=============================================================================
+    void GhostExchange::check_size(std::size_t size) const
+    {
+        if (size != static_cast<std::size_t>(n_local_ * block_size_))
+        {
+            error::invalid_size_error(n_local_ * block_size_, size, __FILE__, __LINE__);
+        }
+    }
+    //=============================================================================
+    void GhostExchange::forward_begin(const Scalar *data)
+    {
+        // Pack the shared owned values
+        for (std::size_t i = 0; i < shared_idxs_.size(); i++)
+        {
+            for (int j = 0; j < block_size_; j++)
+            {
+                shared_buffer_[i * block_size_ + j] = data[shared_idxs_[i] * block_size_ + j];
+            }
+        }
+
+        if (forward_requests_.size() > 0)
+        {
+            MPI_Startall(static_cast<int>(forward_requests_.size()), forward_requests_.data());
+        }
+    }
+    //=============================================================================
+    void GhostExchange::forward_end(Scalar *data)
+    {
+        if (forward_requests_.size() > 0)
+        {
+            MPI_Waitall(static_cast<int>(forward_requests_.size()), forward_requests_.data(), MPI_STATUSES_IGNORE);
+        }
+
+        // Unpack the ghost values
+        for (std::size_t i = 0; i < ghost_idxs_.size(); i++)
+        {
+            for (int j = 0; j < block_size_; j++)
+            {
+                data[ghost_idxs_[i] * block_size_ + j] = ghost_buffer_[i * block_size_ + j];
+            }
+        }
+    }
+    //=============================================================================
+    void GhostExchange::forward(std::vector<Scalar> &data)
+    {
+        check_size(data.size());
+        forward_begin(data.data());
+        forward_end(data.data());
+    }
+    //=============================================================================
+    void GhostExchange::reverse_begin(const Scalar *data)
+    {
+        // Pack the ghost values
+        for (std::size_t i = 0; i < ghost_idxs_.size(); i++)
+        {
+            for (int j = 0; j < block_size_; j++)
+            {
+                ghost_buffer_[i * block_size_ + j] = data[ghost_idxs_[i] * block_size_ + j];
+            }
+        }
+
+        if (reverse_requests_.size() > 0)
+        {
+            MPI_Startall(static_cast<int>(reverse_requests_.size()), reverse_requests_.data());
+        }
+    }
+    //=============================================================================
+    void GhostExchange::reverse_end(Scalar *data)
+    {
+        if (reverse_requests_.size() > 0)
+        {
+            MPI_Waitall(static_cast<int>(reverse_requests_.size()), reverse_requests_.data(), MPI_STATUSES_IGNORE);
+        }
+
+        // Add the received values to the owned values
+        for (std::size_t i = 0; i < shared_idxs_.size(); i++)
+        {
+            for (int j = 0; j < block_size_; j++)
+            {
+                data[shared_idxs_[i] * block_size_ + j] += shared_buffer_[i * block_size_ + j];
+            }
+        }
+    }
+    //=============================================================================
+    void GhostExchange::reverse(std::vector<Scalar> &data)
+    {
+        check_size(data.size());
+        reverse_begin(data.data());
+        reverse_end(data.data());
+    }
+}
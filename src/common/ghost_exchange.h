@@ -0,0 +1,110 @@
+#pragma once
+
+#include "index_map.h"
+#include <mpi.h>
+#include <vector>
+
+namespace sfem::common
+{
+    /// @brief Persistent owner-ghost communication pattern for values laid out
+    /// according to an IndexMap (owned entries first, followed by the ghosts)
+    /// @note Communication happens only with the neighbouring processes, i.e. those
+    /// that own a ghost of this process or have a ghost owned by this process
+    /// @note Each instance communicates on its own duplicate of SFEM_COMM_WORLD, thus
+    /// the updates of different instances may overlap in any order
+    class GhostExchange
+    {
+    public:
+        /// @brief Create a GhostExchange
+        /// @note Collective over SFEM_COMM_WORLD
+        /// @param im Index map describing the owned and ghost indices
+        /// @param block_size Number of values per index
+        GhostExchange(const IndexMap &im, int block_size = 1);
+
+        // Copy constructor (deleted)
+        GhostExchange(const GhostExchange &) = delete;
+
+        // Copy assignment (deleted)
+        GhostExchange &operator=(const GhostExchange &) = delete;
+
+        /// @brief Destructor
+        /// @note Frees the persistent MPI requests and the communicator
+        ~GhostExchange();
+
+        /// @brief Get the number of values per index
+        int block_size() const;
+
+        /// @brief Get the number of local indices (owned + ghost)
+        int n_local() const;
+
+        /// @brief Get the neighbouring processes
+        std::vector<int> neighbours() const;
+
+        /// @brief Start updating the ghost values with the values of their owners
+        /// @param data Local values, of size block_size * n_local
+        void forward_begin(const Scalar *data);
+
+        /// @brief Complete a forward update started by forward_begin
+        /// @param data Local values, of size block_size * n_local
+        void forward_end(Scalar *data);
+
+        /// @brief Update the ghost values with the values of their owners
+        void forward(std::vector<Scalar> &data);
+
+        /// @brief Start adding the ghost values to the values of their owners
+        /// @param data Local values, of size block_size * n_local
+        void reverse_begin(const Scalar *data);
+
+        /// @brief Complete a reverse update started by reverse_begin
+        /// @note The ghost values are left unchanged
+        /// @param data Local values, of size block_size * n_local
+        void reverse_end(Scalar *data);
+
+        /// @brief Add the ghost values to the values of their owners
+        void reverse(std::vector<Scalar> &data);
+
+    private:
+        /// @brief Check the size of a data array
+        void check_size(std::size_t size) const;
+
+    private:
+        /// @brief Number of values per index
+        int block_size_;
+
+        /// @brief Number of local indices
+        int n_local_;
+
+        /// @brief Neighbouring processes that own ghosts of this process
+        std::vector<int> src_ranks_;
+
+        /// @brief Neighbouring processes with ghosts owned by this process
+        std::vector<int> dest_ranks_;
+
+        /// @brief Offsets into ghost_idxs_ for each process in src_ranks_
+        std::vector<int> ghost_ptr_;
+
+        /// @brief Local ghost indices, grouped by owning process
+        std::vector<int> ghost_idxs_;
+
+        /// @brief Offsets into shared_idxs_ for each process in dest_ranks_
+        std::vector<int> shared_ptr_;
+
+        /// @brief Local owned indices that are ghosts to other processes, grouped by process
+        std::vector<int> shared_idxs_;
+
+        /// @brief Buffer for the ghost values
+        std::vector<Scalar> ghost_buffer_;
+
+        /// @brief Buffer for the shared owned values
+        std::vector<Scalar> shared_buffer_;
+
+        /// @brief Communicator of the exchange, duplicated from SFEM_COMM_WORLD
+        MPI_Comm comm_ = MPI_COMM_NULL;
+
+        /// @brief Persistent requests for the forward update
+        std::vector<MPI_Request> forward_requests_;
+
+        /// @brief Persistent requests for the reverse update
+        std::vector<MPI_Request> reverse_requests_;
+    };
+}
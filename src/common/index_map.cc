@@ -1,5 +1,6 @@
 #include "index_map.h"
 #include "error.h"
+#include "mpi_utils.h"
 #include <mpi.h>
 
 namespace sfem::common
@@ -154,14 +155,12 @@ namespace sfem::common
 
         // Renumber the owned indices
         {
-            // Compute the displacement for each process
-            std::vector<int> send_buffer(n_procs, n_owned_);
-            std::vector<int> recv_buffer(n_procs);
-            MPI_Alltoall(send_buffer.data(), 1, MPI_INT, recv_buffer.data(), 1, MPI_INT, SFEM_COMM_WORLD);
+            // Compute the displacement for this process
             int disp = 0;
-            for (int i = 0; i < proc_rank; i++)
+            MPI_Exscan(&n_owned_, &disp, 1, MPI_INT, MPI_SUM, SFEM_COMM_WORLD);
+            if (proc_rank == 0)
             {
-                disp += recv_buffer[i];
+                disp = 0;
             }
 
             // Perform the renumbering
@@ -173,76 +172,53 @@ namespace sfem::common
 
         // Renumber the ghost indices
         {
-            int send_buffer_size = 0;
-            int recv_buffer_size = 0;
-            std::vector<int> send_buffer;
-            std::vector<int> recv_buffer(n_ghost_);
-            std::vector<int> send_counts(n_procs, 0);
-            std::vector<int> recv_counts(n_procs, 0);
-            std::vector<int> send_displs(n_procs, 0);
-            std::vector<int> recv_displs(n_procs, 0);
-
-            // Compute the send buffer counts and displacements
+            // Group the ghost indices by owner
+            std::vector<int> counts(n_procs, 0);
             for (int i = 0; i < n_ghost_; i++)
             {
-                send_counts[ghost_owners_[i]] += 1;
+                counts[ghost_owners_[i]]++;
             }
+            std::vector<int> dest_ranks;
+            std::vector<int> send_ptr = {0};
+            std::vector<int> displs(n_procs, 0);
             for (int i = 0; i < n_procs; i++)
             {
-                if (i > 0)
+                displs[i] = send_ptr.back();
+                if (counts[i] > 0)
                 {
-                    send_displs[i] = send_displs[i - 1] + send_counts[i - 1];
+                    dest_ranks.push_back(i);
+                    send_ptr.push_back(send_ptr.back() + counts[i]);
                 }
-                send_buffer_size += send_counts[i];
             }
-            send_buffer.resize(send_buffer_size);
-
-            // Fill the send buffer
-            std::vector<int> offsets(n_procs, 0);
+            std::vector<int> send_buffer(n_ghost_);
             std::vector<int> position_map(n_ghost_);
             for (int i = 0; i < n_ghost_; i++)
             {
-                int owner = ghost_owners_[i];
-                send_buffer[send_displs[owner] + offsets[owner]] = local_to_global_[i + n_owned_];
-                position_map[i] = send_displs[owner] + offsets[owner];
-                offsets[owner]++;
-            }
-
-            // Compute the receive buffer size, e.g. the total number of ghost nodes this proces will receive
-            MPI_Alltoall(send_counts.data(), 1, MPI_INT, recv_counts.data(), 1, MPI_INT, SFEM_COMM_WORLD);
-            for (int i = 0; i < n_procs; i++)
-            {
-                if (i > 0)
-                {
-                    recv_displs[i] = recv_displs[i - 1] + recv_counts[i - 1];
-                }
-                recv_buffer_size += recv_counts[i];
+                position_map[i] = displs[ghost_owners_[i]]++;
+                send_buffer[position_map[i]] = local_to_global_[i + n_owned_];
             }
-            recv_buffer.resize(recv_buffer_size);
 
             // Send the ghost indices to their owner process
-            MPI_Alltoallv(send_buffer.data(), send_counts.data(), send_displs.data(), MPI_INT,
-                          recv_buffer.data(), recv_counts.data(), recv_displs.data(), MPI_INT,
-                          SFEM_COMM_WORLD);
+            std::vector<int> src_ranks;
+            std::vector<int> recv_ptr;
+            auto recv_buffer = mpi::sparse_exchange(dest_ranks, send_ptr, send_buffer, src_ranks, recv_ptr);
 
             // Renumber the received ghost indices
-            for (int i = 0; i < recv_buffer_size; i++)
+            for (auto &idx : recv_buffer)
             {
-                int old_global_idx = recv_buffer[i];
-                int local_idx = global_to_local_.at(old_global_idx);
-                int new_global_idx = owned_idxs_re[local_idx];
-                recv_buffer[i] = new_global_idx;
+                int local_idx = global_to_local_.at(idx);
+                idx = owned_idxs_re[local_idx];
             }
 
-            // Send the renubmered ghost indices back to the process that sent them
-            MPI_Alltoallv(recv_buffer.data(), recv_counts.data(), recv_displs.data(), MPI_INT,
-                          send_buffer.data(), send_counts.data(), send_displs.data(), MPI_INT,
-                          SFEM_COMM_WORLD);
+            // Send the renumbered ghost indices back to the process that sent them
+            std::vector<int> reply_ranks;
+            std::vector<int> reply_ptr;
+            auto reply_buffer = mpi::sparse_exchange(src_ranks, recv_ptr, recv_buffer, reply_ranks, reply_ptr);
 
-            // Correctly place the renumberd ghost indices
+            // Correctly place the renumbered ghost indices
             for (int i = 0; i < n_ghost_; i++)
             {
-                ghost_idxs_re[i] = send_buffer[position_map[i]];
+                ghost_idxs_re[i] = reply_buffer[position_map[i]];
             }
         }
         return IndexMap(owned_idxs_re, ghost_idxs_re, ghost_owners_);
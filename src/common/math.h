@@ -1,6 +1,7 @@
 #pragma once
 
 #include "logger.h"
+#include <algorithm>
 #include <cmath>
 #include <vector>
 
@@ -149,4 +150,65 @@ namespace sfem::math
 
         return d;
     }
+
+    /// @brief Solve the square linear system m x = b of size r, in place, by Gaussian elimination
+    /// with partial pivoting
+    /// @note On return, b[] holds the solution and m[] is overwritten
+    /// @return Whether the system is non-singular (up to the given relative tolerance on the pivots)
+    inline bool solve(int r, Scalar m[], Scalar b[], Scalar tol = 1e-12)
+    {
+        Scalar scale = 0;
+        for (int i = 0; i < r * r; i++)
+        {
+            scale = std::max(scale, std::abs(m[i]));
+        }
+
+        for (int k = 0; k < r; k++)
+        {
+            // Pivot row
+            int p = k;
+            for (int i = k + 1; i < r; i++)
+            {
+                if (std::abs(m[i * r + k]) > std::abs(m[p * r + k]))
+                {
+                    p = i;
+                }
+            }
+            if (std::abs(m[p * r + k]) <= tol * scale)
+            {
+                return false;
+            }
+            if (p != k)
+            {
+                for (int j = 0; j < r; j++)
+                {
+                    std::swap(m[k * r + j], m[p * r + j]);
+                }
+                std::swap(b[k], b[p]);
+            }
+
+            // Eliminate below the pivot
+            for (int i = k + 1; i < r; i++)
+            {
+                Scalar f = m[i * r + k] / m[k * r + k];
+                for (int j = k; j < r; j++)
+                {
+                    m[i * r + j] -= f * m[k * r + j];
+                }
+                b[i] -= f * b[k];
+            }
+        }
+
+        // Back substitution
+        for (int i = r - 1; i >= 0; i--)
+        {
+            for (int j = i + 1; j < r; j++)
+            {
+                b[i] -= m[i * r + j] * b[j];
+            }
+            b[i] /= m[i * r + i];
+        }
+
+        return true;
+    }
 }
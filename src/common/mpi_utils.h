@@ -1,8 +1,215 @@
 #pragma once
 
+#include "config.h"
+#include "error.h"
+#include <mpi.h>
 #include <vector>
+#include <algorithm>
+#include <type_traits>
 
 namespace sfem::mpi
 {
-    std::vector<int> send_data_to_owners(const std::vector<int> owners, const std::vector<int> data);
-}
\ No newline at end of file
+    /// @brief Get the tag for the next sparse exchange
+    /// @note All processes must call this in the same order,
+    /// so that messages of consecutive exchanges are never mixed up
+    int next_exchange_tag();
+
+    /// @brief Sparse data exchange between processes using non-blocking consensus (NBX)
+    /// @note Collective over SFEM_COMM_WORLD, but each process only communicates
+    /// with the processes it sends data to or receives data from
+    /// @param dest_ranks Processes to which data is sent (must be unique)
+    /// @param send_ptr Offsets into send_data for each process in dest_ranks
+    /// @param send_data Data to be sent
+    /// @param src_ranks Processes from which data was received, sorted by rank (output)
+    /// @param recv_ptr Offsets into the returned data for each process in src_ranks (output)
+    /// @return The received data
+    template <typename T>
+    std::vector<T> sparse_exchange(const std::vector<int> &dest_ranks,
+                                   const std::vector<int> &send_ptr,
+                                   const std::vector<T> &send_data,
+                                   std::vector<int> &src_ranks,
+                                   std::vector<int> &recv_ptr)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "sparse_exchange requires a trivially copyable type");
+
+        if (send_ptr.size() != dest_ranks.size() + 1)
+        {
+            error::invalid_size_error(dest_ranks.size() + 1, send_ptr.size(), __FILE__, __LINE__);
+        }
+
+        int tag = next_exchange_tag();
+
+        // Start the synchronous sends. These complete only once
+        // they have been matched by a receive
+        std::vector<MPI_Request> send_requests(dest_ranks.size());
+        for (std::size_t i = 0; i < dest_ranks.size(); i++)
+        {
+            int n_bytes = (send_ptr[i + 1] - send_ptr[i]) * sizeof(T);
+            MPI_Issend(send_data.data() + send_ptr[i], n_bytes, MPI_BYTE,
+                       dest_ranks[i], tag, SFEM_COMM_WORLD, &send_requests[i]);
+        }
+
+        // Receive messages until all processes have had their sends matched
+        std::vector<std::pair<int, std::vector<T>>> messages;
+        MPI_Request barrier_request;
+        bool barrier_active = false;
+        while (true)
+        {
+            int flag;
+            MPI_Status status;
+            MPI_Iprobe(MPI_ANY_SOURCE, tag, SFEM_COMM_WORLD, &flag, &status);
+            if (flag)
+            {
+                int n_bytes;
+                MPI_Get_count(&status, MPI_BYTE, &n_bytes);
+                std::vector<T> buffer(n_bytes / sizeof(T));
+                MPI_Recv(buffer.data(), n_bytes, MPI_BYTE, status.MPI_SOURCE, tag, SFEM_COMM_WORLD, MPI_STATUS_IGNORE);
+                messages.emplace_back(status.MPI_SOURCE, std::move(buffer));
+            }
+
+            if (barrier_active)
+            {
+                int done;
+                MPI_Test(&barrier_request, &done, MPI_STATUS_IGNORE);
+                if (done)
+                {
+                    break;
+                }
+            }
+            else
+            {
+                int sent;
+                MPI_Testall(static_cast<int>(send_requests.size()), send_requests.data(), &sent, MPI_STATUSES_IGNORE);
+                if (sent)
+                {
+                    MPI_Ibarrier(SFEM_COMM_WORLD, &barrier_request);
+                    barrier_active = true;
+                }
+            }
+        }
+
+        // Order the received data by source process
+        std::sort(messages.begin(), messages.end(),
+                  [](const auto &a, const auto &b)
+                  { return a.first < b.first; });
+        src_ranks.resize(messages.size());
+        recv_ptr.assign(1, 0);
+        for (std::size_t i = 0; i < messages.size(); i++)
+        {
+            src_ranks[i] = messages[i].first;
+            recv_ptr.push_back(recv_ptr.back() + static_cast<int>(messages[i].second.size()));
+        }
+        std::vector<T> recv_data;
+        recv_data.reserve(recv_ptr.back());
+        for (const auto &message : messages)
+        {
+            recv_data.insert(recv_data.end(), message.second.begin(), message.second.end());
+        }
+
+        return recv_data;
+    }
+
+    /// @brief Send each data entry to its owning process
+    /// @param owners Owning process for each entry
+    /// @param data Data to be sent
+    /// @return The data received by this process, ordered by source process
+    template <typename T>
+    std::vector<T> send_data_to_owners(const std::vector<int> &owners, const std::vector<T> &data)
+    {
+        if (owners.size() != data.size())
+        {
+            error::invalid_size_error(owners.size(), data.size(), __FILE__, __LINE__);
+        }
+
+        // Group the data by owner
+        std::vector<int> order(owners.size());
+        for (std::size_t i = 0; i < order.size(); i++)
+        {
+            order[i] = static_cast<int>(i);
+        }
+        std::stable_sort(order.begin(), order.end(),
+                         [&owners](int a, int b)
+                         { return owners[a] < owners[b]; });
+
+        std::vector<int> dest_ranks;
+        std::vector<int> send_ptr = {0};
+        std::vector<T> send_data(data.size());
+        for (std::size_t i = 0; i < order.size(); i++)
+        {
+            int owner = owners[order[i]];
+            if (dest_ranks.size() == 0 || dest_ranks.back() != owner)
+            {
+                dest_ranks.push_back(owner);
+                send_ptr.push_back(send_ptr.back());
+            }
+            send_data[i] = data[order[i]];
+            send_ptr.back()++;
+        }
+
+        std::vector<int> src_ranks;
+        std::vector<int> recv_ptr;
+        return sparse_exchange(dest_ranks, send_ptr, send_data, src_ranks, recv_ptr);
+    }
+
+    /// @brief Send queries to other processes, and collect their answers
+    /// @note Collective. Each process answers all the queries it received at once,
+    /// e.g. to look up the global indices of entities it owns
+    /// @param dest_ranks Process to which each query is sent
+    /// @param queries Queries
+    /// @param answer Callback returning the answer to each of the queries received by this process
+    /// @return The answer to each query, in the same order as the queries
+    template <typename A, typename Q, typename AnswerFn>
+    std::vector<A> query_processes(const std::vector<int> &dest_ranks, const std::vector<Q> &queries, AnswerFn answer)
+    {
+        if (dest_ranks.size() != queries.size())
+        {
+            error::invalid_size_error(dest_ranks.size(), queries.size(), __FILE__, __LINE__);
+        }
+
+        // Group the queries by destination
+        std::vector<int> order(queries.size());
+        for (std::size_t i = 0; i < order.size(); i++)
+        {
+            order[i] = static_cast<int>(i);
+        }
+        std::stable_sort(order.begin(), order.end(),
+                         [&dest_ranks](int a, int b)
+                         { return dest_ranks[a] < dest_ranks[b]; });
+
+        std::vector<int> send_ranks;
+        std::vector<int> send_ptr = {0};
+        std::vector<Q> send_data(queries.size());
+        for (std::size_t i = 0; i < order.size(); i++)
+        {
+            int dest = dest_ranks[order[i]];
+            if (send_ranks.size() == 0 || send_ranks.back() != dest)
+            {
+                send_ranks.push_back(dest);
+                send_ptr.push_back(send_ptr.back());
+            }
+            send_data[i] = queries[order[i]];
+            send_ptr.back()++;
+        }
+
+        // Exchange the queries, and send the answers back to their sources
+        std::vector<int> src_ranks;
+        std::vector<int> recv_ptr;
+        auto received = sparse_exchange(send_ranks, send_ptr, send_data, src_ranks, recv_ptr);
+        std::vector<A> answers = answer(received);
+        if (answers.size() != received.size())
+        {
+            error::invalid_size_error(received.size(), answers.size(), __FILE__, __LINE__);
+        }
+        std::vector<int> reply_ranks;
+        std::vector<int> reply_ptr;
+        auto replies = sparse_exchange(src_ranks, recv_ptr, answers, reply_ranks, reply_ptr);
+
+        // The replies are ordered by source process, i.e. as the grouped queries
+        std::vector<A> result(queries.size());
+        for (std::size_t i = 0; i < order.size(); i++)
+        {
+            result[order[i]] = replies[i];
+        }
+        return result;
+    }
+}
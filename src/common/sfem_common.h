@@ -13,4 +13,5 @@ namespace sfem::common
 #include "init.h"
 #include "math.h"
 #include "index_map.h"
-#include "mpi_utils.h"
\ No newline at end of file
+#include "mpi_utils.h"
+#include "ghost_exchange.h"
\ No newline at end of file
@@ -23,6 +23,10 @@ namespace sfem::fe::constitutive
 
         /// @brief Heat expansion coefficient
         Scalar alpha;
+
+        /// @brief Derivative of the thermal conductivity with respect to the temperature,
+        /// i.e. the conductivity is kappa + dkappa_dT * T
+        Scalar dkappa_dT = 0;
     };
 
     /// @brief Base ThermoElasticConstitutive class
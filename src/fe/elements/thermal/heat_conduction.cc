@@ -46,7 +46,7 @@ namespace sfem::fe::thermal
                                                             Scalar time) const
     {
         int n_nodes = basis_->n_nodes();
-        Scalar kappa = constitutive_.prop().kappa;
+        Scalar kappa = eval_conductivity(data, u);
         Scalar thick = constitutive_.thick();
         la::DenseMatrix Ke(n_nodes, n_nodes);
         for (int i = 0; i < n_nodes; i++)
@@ -68,11 +68,94 @@ namespace sfem::fe::thermal
         la::DenseMatrix Fe(basis_->n_nodes(), 1);
         for (std::size_t i = 0; i < loads_.size(); i++)
         {
-            Fe += loads_[i]->evaluate_load_vector(data, xpts, u);
+            Fe += loads_[i]->evaluate_load_vector(data, xpts, u, time);
         }
         return Fe;
     }
     //=============================================================================
+    la::DenseMatrix HeatConduction2D::evaluate_jacobian_matrix(const FEData &data,
+                                                               const std::vector<Scalar> &xpts,
+                                                               const std::vector<Scalar> &u,
+                                                               Scalar time) const
+    {
+        auto Je = evaluate_stiff_matrix(data, xpts, u, time);
+        Scalar dkappa_dT = constitutive_.prop().dkappa_dT;
+        if (dkappa_dT == 0 || static_cast<int>(u.size()) != n_dof())
+        {
+            return Je;
+        }
+
+        // Derivative of the conductivity: dkappa_dT N_j grad(N_i) . grad(T)
+        int n_nodes = basis_->n_nodes();
+        Scalar thick = constitutive_.thick();
+        for (int i = 0; i < n_nodes; i++)
+        {
+            Scalar dNi_dT = 0;
+            for (int k = 0; k < n_nodes; k++)
+            {
+                for (int d = 0; d < 2; d++)
+                {
+                    dNi_dT += data.dNdX[i * 3 + d] * data.dNdX[k * 3 + d] * u[k];
+                }
+            }
+            for (int j = 0; j < n_nodes; j++)
+            {
+                Je.add(i, j, thick * dkappa_dT * data.N[j] * dNi_dT);
+            }
+        }
+        return Je;
+    }
+    //=============================================================================
+    la::DenseMatrix HeatConduction2D::evaluate_residual_vector(const FEData &data,
+                                                               const std::vector<Scalar> &xpts,
+                                                               const std::vector<Scalar> &u,
+                                                               Scalar time) const
+    {
+        auto Re = evaluate_load_vector(data, xpts, u, time) * -1.0;
+        if (static_cast<int>(u.size()) != n_dof())
+        {
+            return Re;
+        }
+
+        // Internal heat flow: kappa(T) grad(N_i) . grad(T)
+        int n_nodes = basis_->n_nodes();
+        Scalar kappa = eval_conductivity(data, u);
+        Scalar thick = constitutive_.thick();
+        std::array<Scalar, 3> dTdX = {0};
+        for (int k = 0; k < n_nodes; k++)
+        {
+            for (int d = 0; d < 2; d++)
+            {
+                dTdX[d] += data.dNdX[k * 3 + d] * u[k];
+            }
+        }
+        for (int i = 0; i < n_nodes; i++)
+        {
+            for (int d = 0; d < 2; d++)
+            {
+                Re.add(i, 0, thick * kappa * data.dNdX[i * 3 + d] * dTdX[d]);
+            }
+        }
+        return Re;
+    }
+    //=============================================================================
+    Scalar HeatConduction2D::eval_conductivity(const FEData &data, const std::vector<Scalar> &u) const
+    {
+        Scalar kappa = constitutive_.prop().kappa;
+        Scalar dkappa_dT = constitutive_.prop().dkappa_dT;
+        if (dkappa_dT == 0 || static_cast<int>(u.size()) != n_dof())
+        {
+            return kappa;
+        }
+
+        Scalar T = 0;
+        for (int i = 0; i < basis_->n_nodes(); i++)
+        {
+            T += data.N[i] * u[i];
+        }
+        return kappa + dkappa_dT * T;
+    }
+    //=============================================================================
     HeatConduction3D::HeatConduction3D(const mesh::Cell cell,
                                        constitutive::ThermoElasticSolidConstitutive &constitutive)
         : FiniteElement("HeatConduction3D", 1, 3, cell),
@@ -115,7 +198,7 @@ namespace sfem::fe::thermal
                                                             Scalar time) const
     {
         int n_nodes = basis_->n_nodes();
-        Scalar kappa = constitutive_.prop().kappa;
+        Scalar kappa = eval_conductivity(data, u);
         la::DenseMatrix Ke(n_nodes, n_nodes);
         for (int i = 0; i < n_nodes; i++)
         {
@@ -137,8 +220,89 @@ namespace sfem::fe::thermal
         la::DenseMatrix Fe(basis_->n_nodes(), 1);
         for (std::size_t i = 0; i < loads_.size(); i++)
         {
-            Fe += loads_[i]->evaluate_load_vector(data, xpts, u);
+            Fe += loads_[i]->evaluate_load_vector(data, xpts, u, time);
         }
         return Fe;
     }
+    //=============================================================================
+    la::DenseMatrix HeatConduction3D::evaluate_jacobian_matrix(const FEData &data,
+                                                               const std::vector<Scalar> &xpts,
+                                                               const std::vector<Scalar> &u,
+                                                               Scalar time) const
+    {
+        auto Je = evaluate_stiff_matrix(data, xpts, u, time);
+        Scalar dkappa_dT = constitutive_.prop().dkappa_dT;
+        if (dkappa_dT == 0 || static_cast<int>(u.size()) != n_dof())
+        {
+            return Je;
+        }
+
+        // Derivative of the conductivity: dkappa_dT N_j grad(N_i) . grad(T)
+        int n_nodes = basis_->n_nodes();
+        for (int i = 0; i < n_nodes; i++)
+        {
+            Scalar dNi_dT = 0;
+            for (int k = 0; k < n_nodes; k++)
+            {
+                for (int d = 0; d < 3; d++)
+                {
+                    dNi_dT += data.dNdX[i * 3 + d] * data.dNdX[k * 3 + d] * u[k];
+                }
+            }
+            for (int j = 0; j < n_nodes; j++)
+            {
+                Je.add(i, j, dkappa_dT * data.N[j] * dNi_dT);
+            }
+        }
+        return Je;
+    }
+    //=============================================================================
+    la::DenseMatrix HeatConduction3D::evaluate_residual_vector(const FEData &data,
+                                                               const std::vector<Scalar> &xpts,
+                                                               const std::vector<Scalar> &u,
+                                                               Scalar time) const
+    {
+        auto Re = evaluate_load_vector(data, xpts, u, time) * -1.0;
+        if (static_cast<int>(u.size()) != n_dof())
+        {
+            return Re;
+        }
+
+        // Internal heat flow: kappa(T) grad(N_i) . grad(T)
+        int n_nodes = basis_->n_nodes();
+        Scalar kappa = eval_conductivity(data, u);
+        std::array<Scalar, 3> dTdX = {0};
+        for (int k = 0; k < n_nodes; k++)
+        {
+            for (int d = 0; d < 3; d++)
+            {
+                dTdX[d] += data.dNdX[k * 3 + d] * u[k];
+            }
+        }
+        for (int i = 0; i < n_nodes; i++)
+        {
+            for (int d = 0; d < 3; d++)
+            {
+                Re.add(i, 0, kappa * data.dNdX[i * 3 + d] * dTdX[d]);
+            }
+        }
+        return Re;
+    }
+    //=============================================================================
+    Scalar HeatConduction3D::eval_conductivity(const FEData &data, const std::vector<Scalar> &u) const
+    {
+        Scalar kappa = constitutive_.prop().kappa;
+        Scalar dkappa_dT = constitutive_.prop().dkappa_dT;
+        if (dkappa_dT == 0 || static_cast<int>(u.size()) != n_dof())
+        {
+            return kappa;
+        }
+
+        Scalar T = 0;
+        for (int i = 0; i < basis_->n_nodes(); i++)
+        {
+            T += data.N[i] * u[i];
+        }
+        return kappa + dkappa_dT * T;
+    }
 }
\ No newline at end of file
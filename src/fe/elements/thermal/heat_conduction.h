@@ -7,6 +7,9 @@
 
 namespace sfem::fe::thermal
 {
+    /// @brief Heat conduction element for plane problems
+    /// @note The conductivity may depend linearly on the temperature, see ThermoMechanicalProperties,
+    /// in which case the stiffness matrix is the secant one and the Jacobian the consistent tangent
     class HeatConduction2D : public FiniteElement
     {
     public:
@@ -31,7 +34,20 @@ namespace sfem::fe::thermal
                                              const std::vector<Scalar> &u,
                                              Scalar time = 0) const override;
 
+        la::DenseMatrix evaluate_jacobian_matrix(const FEData &data,
+                                                 const std::vector<Scalar> &xpts,
+                                                 const std::vector<Scalar> &u,
+                                                 Scalar time = 0) const override;
+
+        la::DenseMatrix evaluate_residual_vector(const FEData &data,
+                                                 const std::vector<Scalar> &xpts,
+                                                 const std::vector<Scalar> &u,
+                                                 Scalar time = 0) const override;
+
     private:
+        /// @brief Evaluate the (temperature-dependent) thermal conductivity at a quadrature point
+        Scalar eval_conductivity(const FEData &data, const std::vector<Scalar> &u) const;
+
         /// @brief Constitutive
         constitutive::ThermoElasticPlaneConstitutive &constitutive_;
 
@@ -39,6 +55,8 @@ namespace sfem::fe::thermal
         std::vector<std::shared_ptr<FiniteElement>> loads_;
     };
 
+    /// @brief Heat conduction element for solid problems
+    /// @note See HeatConduction2D for temperature-dependent conductivity
     class HeatConduction3D : public FiniteElement
     {
     public:
@@ -63,7 +81,20 @@ namespace sfem::fe::thermal
                                              const std::vector<Scalar> &u,
                                              Scalar time = 0) const override;
 
+        la::DenseMatrix evaluate_jacobian_matrix(const FEData &data,
+                                                 const std::vector<Scalar> &xpts,
+                                                 const std::vector<Scalar> &u,
+                                                 Scalar time = 0) const override;
+
+        la::DenseMatrix evaluate_residual_vector(const FEData &data,
+                                                 const std::vector<Scalar> &xpts,
+                                                 const std::vector<Scalar> &u,
+                                                 Scalar time = 0) const override;
+
     private:
+        /// @brief Evaluate the (temperature-dependent) thermal conductivity at a quadrature point
+        Scalar eval_conductivity(const FEData &data, const std::vector<Scalar> &u) const;
+
         /// @brief Constitutive
         constitutive::ThermoElasticSolidConstitutive &constitutive_;
 
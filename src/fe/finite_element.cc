@@ -123,13 +123,16 @@ namespace sfem::fe
             switch (type)
             {
             case FEMatrixType::mass:
-                M += evaluate_mass_matrix(data, xpts, u) * qwt_detJ;
+                M += evaluate_mass_matrix(data, xpts, u, time) * qwt_detJ;
                 break;
             case FEMatrixType::damping:
-                M += evaluate_damping_matrix(data, xpts, u) * qwt_detJ;
+                M += evaluate_damping_matrix(data, xpts, u, time) * qwt_detJ;
                 break;
             case FEMatrixType::stiffness:
-                M += evaluate_stiff_matrix(data, xpts, u) * qwt_detJ;
+                M += evaluate_stiff_matrix(data, xpts, u, time) * qwt_detJ;
+                break;
+            case FEMatrixType::jacobian:
+                M += evaluate_jacobian_matrix(data, xpts, u, time) * qwt_detJ;
                 break;
             default:
                 break;
@@ -153,7 +156,10 @@ namespace sfem::fe
             switch (type)
             {
             case FEVectorType::load:
-                F += evaluate_load_vector(data, xpts, u) * qwt_detJ;
+                F += evaluate_load_vector(data, xpts, u, time) * qwt_detJ;
+                break;
+            case FEVectorType::residual:
+                F += evaluate_residual_vector(data, xpts, u, time) * qwt_detJ;
                 break;
             default:
                 break;
@@ -172,7 +178,7 @@ namespace sfem::fe
         for (int npt = 0; npt < basis_->n_qpts(); npt++)
         {
             auto data = transform_basis(npt, xpts);
-            F += func(*this, data, xpts, u) * data.detJ * data.qwt;
+            F += func(*this, data, xpts, u, time) * data.detJ * data.qwt;
         }
         return F;
     }
@@ -188,7 +194,7 @@ namespace sfem::fe
         for (int npt = 0; npt < basis_->n_qpts(); npt++)
         {
             auto data = transform_basis(npt, xpts);
-            auto values = func(*this, data, xpts, u);
+            auto values = func(*this, data, xpts, u, time);
 
             for (int i = 0; i < cell_.n_nodes(); i++)
             {
@@ -160,6 +160,42 @@ namespace sfem::fe
             return la::DenseMatrix(n_dof(), 1);
         }
 
+        /// @brief Evaluate the element tangent (Jacobian) matrix, i.e. the derivative of
+        /// the element residual with respect to the field values
+        /// @note  Returns the stiffness matrix if not overwritten, i.e. for linear elements
+        /// @param data Basis transformation data
+        /// @param xpts Element nodal positions
+        /// @param u Field values corresponding to the element nodes
+        /// @param Current solution time
+        /// @return Element Jacobian matrix
+        virtual la::DenseMatrix evaluate_jacobian_matrix(const FEData &data,
+                                                         const std::vector<Scalar> &xpts,
+                                                         const std::vector<Scalar> &u,
+                                                         Scalar time = 0) const
+        {
+            return evaluate_stiff_matrix(data, xpts, u, time);
+        }
+
+        /// @brief Evaluate the element residual vector, i.e. the internal minus the external forces
+        /// @note  Returns K u - F if not overwritten, i.e. for linear elements
+        /// @param data Basis transformation data
+        /// @param xpts Element nodal positions
+        /// @param u Field values corresponding to the element nodes
+        /// @param Current solution time
+        /// @return Element residual vector
+        virtual la::DenseMatrix evaluate_residual_vector(const FEData &data,
+                                                         const std::vector<Scalar> &xpts,
+                                                         const std::vector<Scalar> &u,
+                                                         Scalar time = 0) const
+        {
+            auto Re = evaluate_load_vector(data, xpts, u, time) * -1.0;
+            if (static_cast<int>(u.size()) == n_dof())
+            {
+                Re += evaluate_stiff_matrix(data, xpts, u, time) * la::DenseMatrix(n_dof(), 1, u);
+            }
+            return Re;
+        }
+
         la::DenseMatrix integrate_fe_matrix(const std::vector<Scalar> &xpts,
                                             const std::vector<Scalar> &u,
                                             FEMatrixType type,
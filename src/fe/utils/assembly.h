@@ -1,15 +1,165 @@
 #pragma once
 
 #include "../finite_element.h"
+#include "../functions/function.h"
 #include "../../la/petsc/petsc_mat.h"
 #include "../../la/petsc/petsc_vec.h"
 #include "../../mesh/field.h"
 #include "../../common/timer.h"
+#include "../../common/logger.h"
+#include "../../common/error.h"
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
 
 namespace sfem::fe
 {
 
+    /// @brief Split elements into interface elements, i.e. elements with at least one ghost node,
+    /// and interior elements, i.e. elements whose nodes are all locally owned
+    /// @note Contributions from interior elements never have to be communicated,
+    /// thus they can be computed while the interface contributions are being exchanged
+    /// @param elems The elements
+    /// @param mesh Mesh on which the elements are defined
+    /// @return The positions in elems of the interface and interior elements
+    inline std::pair<std::vector<std::size_t>, std::vector<std::size_t>>
+    split_interface_elements(const std::vector<std::shared_ptr<FiniteElement>> &elems,
+                             const mesh::Mesh &mesh)
+    {
+        std::vector<std::size_t> interface_elems;
+        std::vector<std::size_t> interior_elems;
+        for (std::size_t i = 0; i < elems.size(); i++)
+        {
+            if (mesh.is_interface_cell(elems[i]->cell()))
+            {
+                interface_elems.push_back(i);
+            }
+            else
+            {
+                interior_elems.push_back(i);
+            }
+        }
+        return std::make_pair(interface_elems, interior_elems);
+    }
+
+    /// @brief Contribution of a single element to a global matrix and/or vector
+    struct ElementContribution
+    {
+        /// @brief Row indices (negative indices are ignored)
+        std::vector<int> rows;
+
+        /// @brief Column indices (negative indices are ignored)
+        std::vector<int> cols;
+
+        /// @brief Matrix values, stored row-wise
+        std::vector<Scalar> mat_values;
+
+        /// @brief Vector values
+        std::vector<Scalar> vec_values;
+    };
+
+    /// @brief Insert element contributions into a global PetscMat and/or PetscVec, and assemble them
+    /// @note The interface elements are inserted first, and their off-process entries are communicated by a
+    /// flush assembly. Meanwhile, a batch of interior elements, as large as the set of interface elements, is
+    /// computed into a buffer. The buffered and the remaining interior elements are inserted once the flush
+    /// has completed, followed by the final assembly, which only involves locally owned entries.
+    /// Thus, no values are set while an assembly is in progress
+    /// @note With a layer of ghost cells, no off-process entries exist, and the elements are simply
+    /// inserted in order
+    /// @param elems The contributing elements
+    /// @param mesh Mesh on which the elements are defined
+    /// @param mat PetscMat where the matrix values are inserted (may be nullptr)
+    /// @param vec PetscVec where the vector values are inserted (may be nullptr)
+    /// @param compute Callable computing the contribution of an element, i.e. void(const FiniteElement &, ElementContribution &)
+    /// @param add_owned Callable adding further owned entries before the final assembly, i.e. void()
+    template <typename ComputeFn, typename AddOwnedFn>
+    inline void insert_element_contributions(const std::vector<std::shared_ptr<FiniteElement>> &elems,
+                                             const mesh::Mesh &mesh,
+                                             la::petsc::PetscMat *mat,
+                                             la::petsc::PetscVec *vec,
+                                             ComputeFn compute,
+                                             AddOwnedFn add_owned)
+    {
+        auto insert = [&](const ElementContribution &c)
+        {
+            if (mat)
+            {
+                mat->add_values(c.rows, c.cols, c.mat_values);
+            }
+            if (vec)
+            {
+                vec->add_values(c.rows, c.vec_values);
+            }
+        };
+
+        ElementContribution contribution;
+        if (mesh.has_ghost_cells() || Logger::instance().n_procs() == 1)
+        {
+            for (const auto &elem : elems)
+            {
+                compute(*elem, contribution);
+                insert(contribution);
+            }
+        }
+        else
+        {
+            auto [interface_elems, interior_elems] = split_interface_elements(elems, mesh);
+            for (auto i : interface_elems)
+            {
+                compute(*elems[i], contribution);
+                insert(contribution);
+            }
+            if (mat)
+            {
+                mat->assemble_begin(MAT_FLUSH_ASSEMBLY);
+            }
+            if (vec)
+            {
+                vec->assemble_begin();
+            }
+
+            // Compute a batch of interior elements while the off-process entries are in flight
+            std::size_t n_buffered = std::min(interior_elems.size(), interface_elems.size());
+            std::vector<ElementContribution> buffer(n_buffered);
+            for (std::size_t i = 0; i < n_buffered; i++)
+            {
+                compute(*elems[interior_elems[i]], buffer[i]);
+            }
+
+            if (mat)
+            {
+                mat->assemble_end(MAT_FLUSH_ASSEMBLY);
+            }
+            if (vec)
+            {
+                vec->assemble_end();
+            }
+
+            for (const auto &c : buffer)
+            {
+                insert(c);
+            }
+            for (std::size_t i = n_buffered; i < interior_elems.size(); i++)
+            {
+                compute(*elems[interior_elems[i]], contribution);
+                insert(contribution);
+            }
+        }
+
+        add_owned();
+        if (mat)
+        {
+            mat->assemble();
+        }
+        if (vec)
+        {
+            vec->assemble();
+        }
+    }
+
     /// @brief Assemble matrix contributions from elements into a PetscMat
+    /// @note The communication of off-process entries overlaps with the
+    /// computation of interior elements, see insert_element_contributions
     /// @param elems The contributing elements
     /// @param field Corresponding field
     /// @param type Element matrix type, e.g stiffness
@@ -26,22 +176,32 @@ namespace sfem::fe
 
         auto &mesh = field.mesh();
 
-        for (const auto &elem : elems)
+        // With a layer of ghost cells, each process computes all contributions
+        // to its owned rows, thus no off-process entries have to be communicated
+        bool owner_computes = mesh.has_ghost_cells();
+        if (owner_computes)
+        {
+            MatSetOption(mat.mat(), MAT_NO_OFF_PROC_ENTRIES, PETSC_TRUE);
+        }
+
+        auto compute_elem_contribution = [&](const FiniteElement &elem, ElementContribution &c)
         {
             // Cell data
-            auto xpts = mesh.get_cell_xpts(elem->cell());
-            auto dof = field.get_cell_dof(elem->cell());
-            auto u = field.get_cell_values(elem->cell());
+            auto xpts = mesh.get_cell_xpts(elem.cell());
+            auto u = field.get_cell_values(elem.cell());
+            c.cols = field.get_cell_dof(elem.cell());
+            c.rows = owner_computes ? field.get_cell_owned_dof(elem.cell()) : c.cols;
 
-            // Integrate and add contribution
-            auto elem_matrix = elem->integrate_fe_matrix(xpts, u, type, time);
-            mat.add_values(dof, elem_matrix.entries());
-        }
+            // Integrate
+            c.mat_values = elem.integrate_fe_matrix(xpts, u, type, time).entries();
+        };
 
-        mat.assemble();
+        insert_element_contributions(elems, mesh, &mat, nullptr, compute_elem_contribution, [] {});
     }
 
     /// @brief Assemble vector contributions from elements into a PetscVec
+    /// @note The communication of off-process entries overlaps with the
+    /// computation of interior elements, see insert_element_contributions
     /// @param elems The contributing elements
     /// @param field Corresponding field
     /// @param type Element vector type, e.g. load
@@ -58,19 +218,659 @@ namespace sfem::fe
 
         auto &mesh = field.mesh();
 
-        for (const auto &elem : elems)
+        // With a layer of ghost cells, each process computes all contributions
+        // to its owned entries, thus no off-process entries have to be communicated
+        bool owner_computes = mesh.has_ghost_cells();
+        if (owner_computes)
+        {
+            VecSetOption(vec.vec(), VEC_IGNORE_OFF_PROC_ENTRIES, PETSC_TRUE);
+        }
+
+        auto compute_elem_contribution = [&](const FiniteElement &elem, ElementContribution &c)
         {
             // Cell data
-            auto xpts = mesh.get_cell_xpts(elem->cell());
-            auto dof = field.get_cell_dof(elem->cell());
-            auto u = field.get_cell_values(elem->cell());
+            auto xpts = mesh.get_cell_xpts(elem.cell());
+            auto u = field.get_cell_values(elem.cell());
+            c.rows = owner_computes ? field.get_cell_owned_dof(elem.cell()) : field.get_cell_dof(elem.cell());
+
+            // Integrate
+            c.vec_values = elem.integrate_fe_vector(xpts, u, type, time).entries();
+        };
+
+        insert_element_contributions(elems, mesh, nullptr, &vec, compute_elem_contribution, [] {});
+    }
+
+    /// @brief Assemble vector contributions from elements into an array of local DoF values,
+    /// laid out as the Field values (owned DoF first, followed by the ghost DoF)
+    /// @note Ghost contributions are sent to their owners using the Field's GhostExchange,
+    /// while the interior elements are being assembled
+    /// @note On return, the owned entries hold the assembled values, while the ghost entries hold
+    /// only the local contributions. Use the Field's GhostExchange to update them, if required
+    /// @note With a layer of ghost cells, the owned entries are computed locally, without communication,
+    /// and the ghost entries are set to zero
+    /// @param elems The contributing elements
+    /// @param field Corresponding field
+    /// @param type Element vector type, e.g. load
+    /// @param values Local values, of size field.n_dof_local(), where the contributions are added
+    /// @param time Current solution time
+    inline void assemble_vector_local(const std::vector<std::shared_ptr<FiniteElement>> &elems,
+                                      const mesh::Field &field,
+                                      FEVectorType type,
+                                      std::vector<Scalar> &values,
+                                      Scalar time = 0)
+    {
+        // Time the assembly
+        common::Timer timer("Local vector assembly");
+
+        if (values.size() != static_cast<std::size_t>(field.n_dof_local()))
+        {
+            error::invalid_size_error(field.n_dof_local(), values.size(), __FILE__, __LINE__);
+        }
+
+        auto &mesh = field.mesh();
+        auto ghost_exchange = field.ghost_exchange();
+
+        // With a layer of ghost cells, only the owned entries are computed,
+        // and no communication is required
+        bool owner_computes = mesh.has_ghost_cells();
+        int n_dof_computed = owner_computes ? field.n_dof_owned() : field.n_dof_local();
+
+        // Only the contributions of this process must be sent to the ghost owners
+        std::fill(values.begin() + field.n_dof_owned(), values.end(), 0.0);
+
+        auto add_elem_contribution = [&](const FiniteElement &elem)
+        {
+            // Cell data
+            auto xpts = mesh.get_cell_xpts(elem.cell());
+            auto dof = field.map_node_dof(mesh.get_cell_nodes(elem.cell()));
+            auto u = field.get_cell_values(elem.cell());
 
             // Integrate and add contribution
-            auto elem_vec = elem->integrate_fe_vector(xpts, u, type, time);
-            vec.add_values(dof, elem_vec.entries());
+            auto elem_vec = elem.integrate_fe_vector(xpts, u, type, time);
+            const auto &entries = elem_vec.entries();
+            for (std::size_t i = 0; i < dof.size(); i++)
+            {
+                if (dof[i] < n_dof_computed)
+                {
+                    values[dof[i]] += entries[i];
+                }
+            }
+        };
+
+        if (owner_computes)
+        {
+            for (const auto &elem : elems)
+            {
+                add_elem_contribution(*elem);
+            }
+            return;
         }
 
-        vec.assemble();
+        auto [interface_elems, interior_elems] = split_interface_elements(elems, mesh);
+        for (auto i : interface_elems)
+        {
+            add_elem_contribution(*elems[i]);
+        }
+        ghost_exchange->reverse_begin(values.data());
+        for (auto i : interior_elems)
+        {
+            add_elem_contribution(*elems[i]);
+        }
+        ghost_exchange->reverse_end(values.data());
+    }
+
+    /// @brief Compute the action of an element matrix type on a vector, without assembling the matrix,
+    /// i.e. y = A * x, where A is the matrix of the given type
+    /// @note Ghost contributions are sent to their owners using the Field's GhostExchange,
+    /// while the interior elements are being computed
+    /// @note On return, the owned entries of y hold the result, while the ghost entries hold
+    /// only the local contributions. With a layer of ghost cells, the ghost entries are set to zero
+    /// @param elems The contributing elements
+    /// @param field Corresponding field
+    /// @param type Element matrix type, e.g stiffness
+    /// @param x Local values (owned and ghost), of size field.n_dof_local(). The ghost values must be up to date
+    /// @param y Local values, of size field.n_dof_local(), where the result is stored
+    /// @param time Current solution time
+    inline void assemble_matrix_action(const std::vector<std::shared_ptr<FiniteElement>> &elems,
+                                       const mesh::Field &field,
+                                       FEMatrixType type,
+                                       const std::vector<Scalar> &x,
+                                       std::vector<Scalar> &y,
+                                       Scalar time = 0)
+    {
+        // Time the assembly
+        common::Timer timer("Matrix action assembly");
+
+        if (x.size() != static_cast<std::size_t>(field.n_dof_local()))
+        {
+            error::invalid_size_error(field.n_dof_local(), x.size(), __FILE__, __LINE__);
+        }
+
+        auto &mesh = field.mesh();
+        auto ghost_exchange = field.ghost_exchange();
+
+        // With a layer of ghost cells, only the owned entries are computed,
+        // and no communication is required
+        bool owner_computes = mesh.has_ghost_cells();
+        int n_dof_computed = owner_computes ? field.n_dof_owned() : field.n_dof_local();
+
+        y.assign(field.n_dof_local(), 0.0);
+
+        auto add_elem_contribution = [&](const FiniteElement &elem)
+        {
+            // Cell data
+            auto xpts = mesh.get_cell_xpts(elem.cell());
+            auto dof = field.map_node_dof(mesh.get_cell_nodes(elem.cell()));
+            auto u = field.get_cell_values(elem.cell());
+
+            // Integrate and add contribution
+            auto elem_matrix = elem.integrate_fe_matrix(xpts, u, type, time);
+            int n_dof = static_cast<int>(dof.size());
+            for (int i = 0; i < n_dof; i++)
+            {
+                if (dof[i] >= n_dof_computed)
+                {
+                    continue;
+                }
+                Scalar sum = 0;
+                for (int j = 0; j < n_dof; j++)
+                {
+                    sum += elem_matrix.at(i, j) * x[dof[j]];
+                }
+                y[dof[i]] += sum;
+            }
+        };
+
+        if (owner_computes)
+        {
+            for (const auto &elem : elems)
+            {
+                add_elem_contribution(*elem);
+            }
+            return;
+        }
+
+        auto [interface_elems, interior_elems] = split_interface_elements(elems, mesh);
+        for (auto i : interface_elems)
+        {
+            add_elem_contribution(*elems[i]);
+        }
+        ghost_exchange->reverse_begin(y.data());
+        for (auto i : interior_elems)
+        {
+            add_elem_contribution(*elems[i]);
+        }
+        ghost_exchange->reverse_end(y.data());
+    }
+
+    /// @brief Ways to lump an element matrix into a diagonal
+    enum class MatrixLumping
+    {
+        /// @brief Sum of each row
+        row_sum = 0,
+
+        /// @brief Diagonal scaled to preserve the total of each variable's block,
+        /// i.e. HRZ (Hinton, Rock & Zienkiewicz) lumping. Always positive for mass matrices
+        diagonal_scaling = 1,
+
+        /// @brief Sum of the absolute values of each row, e.g. for Gershgorin eigenvalue bounds
+        absolute_row_sum = 2
+    };
+
+    /// @brief Assemble the lumped (diagonal) form of an element matrix type into an array of local DoF values,
+    /// laid out as the Field values (owned DoF first, followed by the ghost DoF)
+    /// @note The element matrices are lumped before assembly, thus no global matrix is formed
+    /// @note Ghost contributions are sent to their owners using the Field's GhostExchange,
+    /// see assemble_vector_local()
+    /// @param elems The contributing elements
+    /// @param field Corresponding field
+    /// @param type Element matrix type, e.g. mass
+    /// @param lumping Lumping method
+    /// @param values Local values, of size field.n_dof_local(), where the contributions are added
+    /// @param time Current solution time
+    inline void assemble_lumped_matrix(const std::vector<std::shared_ptr<FiniteElement>> &elems,
+                                       const mesh::Field &field,
+                                       FEMatrixType type,
+                                       MatrixLumping lumping,
+                                       std::vector<Scalar> &values,
+                                       Scalar time = 0)
+    {
+        // Time the assembly
+        common::Timer timer("Lumped matrix assembly");
+
+        if (values.size() != static_cast<std::size_t>(field.n_dof_local()))
+        {
+            error::invalid_size_error(field.n_dof_local(), values.size(), __FILE__, __LINE__);
+        }
+
+        auto &mesh = field.mesh();
+        auto ghost_exchange = field.ghost_exchange();
+
+        // With a layer of ghost cells, only the owned entries are computed,
+        // and no communication is required
+        bool owner_computes = mesh.has_ghost_cells();
+        int n_dof_computed = owner_computes ? field.n_dof_owned() : field.n_dof_local();
+
+        // Only the contributions of this process must be sent to the ghost owners
+        std::fill(values.begin() + field.n_dof_owned(), values.end(), 0.0);
+
+        auto add_elem_contribution = [&](const FiniteElement &elem)
+        {
+            // Cell data
+            auto xpts = mesh.get_cell_xpts(elem.cell());
+            auto dof = field.map_node_dof(mesh.get_cell_nodes(elem.cell()));
+            auto u = field.get_cell_values(elem.cell());
+
+            // Integrate and lump
+            auto elem_matrix = elem.integrate_fe_matrix(xpts, u, type, time);
+            int n_dof = static_cast<int>(dof.size());
+            std::vector<Scalar> diag(n_dof, 0.0);
+            if (lumping == MatrixLumping::diagonal_scaling)
+            {
+                // Variables are interleaved, i.e. the DoF i belongs to the variable i % n_vars
+                int n_vars = elem.n_vars();
+                for (int k = 0; k < n_vars; k++)
+                {
+                    Scalar total = 0;
+                    Scalar diag_total = 0;
+                    for (int i = k; i < n_dof; i += n_vars)
+                    {
+                        for (int j = k; j < n_dof; j += n_vars)
+                        {
+                            total += elem_matrix.at(i, j);
+                        }
+                        diag_total += elem_matrix.at(i, i);
+                    }
+                    for (int i = k; i < n_dof; i += n_vars)
+                    {
+                        diag[i] = diag_total != 0 ? elem_matrix.at(i, i) * total / diag_total : 0;
+                    }
+                }
+            }
+            else
+            {
+                bool absolute = lumping == MatrixLumping::absolute_row_sum;
+                for (int i = 0; i < n_dof; i++)
+                {
+                    for (int j = 0; j < n_dof; j++)
+                    {
+                        diag[i] += absolute ? std::abs(elem_matrix.at(i, j)) : elem_matrix.at(i, j);
+                    }
+                }
+            }
+
+            // Add contribution
+            for (int i = 0; i < n_dof; i++)
+            {
+                if (dof[i] < n_dof_computed)
+                {
+                    values[dof[i]] += diag[i];
+                }
+            }
+        };
+
+        if (owner_computes)
+        {
+            for (const auto &elem : elems)
+            {
+                add_elem_contribution(*elem);
+            }
+            return;
+        }
+
+        auto [interface_elems, interior_elems] = split_interface_elements(elems, mesh);
+        for (auto i : interface_elems)
+        {
+            add_elem_contribution(*elems[i]);
+        }
+        ghost_exchange->reverse_begin(values.data());
+        for (auto i : interior_elems)
+        {
+            add_elem_contribution(*elems[i]);
+        }
+        ghost_exchange->reverse_end(values.data());
+    }
+
+    /// @brief Get a mask of the fixed DoF for all local DoF (owned + ghost) and their values
+    /// @note Collective, see mesh::Field::get_local_fixed_dof
+    /// @param field The field
+    /// @return Whether each local DoF is fixed, and the fixed value (zero for free DoF)
+    inline std::pair<std::vector<bool>, std::vector<Scalar>> get_fixed_dof_mask(const mesh::Field &field)
+    {
+        std::vector<bool> is_fixed(field.n_dof_local(), false);
+        std::vector<Scalar> fixed_values(field.n_dof_local(), 0.0);
+        auto [local_fixed_dof, local_fixed_dof_values] = field.get_local_fixed_dof();
+        for (std::size_t i = 0; i < local_fixed_dof.size(); i++)
+        {
+            is_fixed[local_fixed_dof[i]] = true;
+            fixed_values[local_fixed_dof[i]] = local_fixed_dof_values[i];
+        }
+        return std::make_pair(is_fixed, fixed_values);
+    }
+
+    /// @brief Assemble a linear system Ax=b from element contributions, with the fixed DoF eliminated
+    /// @note The rows and columns of A corresponding to fixed DoF are never inserted. Instead, their
+    /// diagonal entries are set to diag, the corresponding entries of b to diag times the fixed value,
+    /// and the contribution of the fixed DoF is subtracted from b at the element level (lifting).
+    /// Thus, the symmetry of A is preserved and no MatZeroRowsColumns is required
+    /// @param elems The contributing elements
+    /// @param field Corresponding field, which holds the fixed DoF
+    /// @param mat_type Element matrix type, e.g stiffness
+    /// @param vec_type Element vector type, e.g. load
+    /// @param A PetscMat where the matrix entries are assembled
+    /// @param b PetscVec where the vector entries are assembled
+    /// @param time Current solution time
+    /// @param diag Value placed on the diagonal for the fixed DoF
+    inline void assemble_constrained_system(const std::vector<std::shared_ptr<FiniteElement>> &elems,
+                                            const mesh::Field &field,
+                                            FEMatrixType mat_type,
+                                            FEVectorType vec_type,
+                                            la::petsc::PetscMat &A,
+                                            la::petsc::PetscVec &b,
+                                            Scalar time = 0,
+                                            Scalar diag = 1.0)
+    {
+        // Time the assembly
+        common::Timer timer("Constrained system assembly");
+
+        auto &mesh = field.mesh();
+        auto [is_fixed, fixed_values] = get_fixed_dof_mask(field);
+
+        // See assemble_matrix
+        bool owner_computes = mesh.has_ghost_cells();
+        if (owner_computes)
+        {
+            MatSetOption(A.mat(), MAT_NO_OFF_PROC_ENTRIES, PETSC_TRUE);
+            VecSetOption(b.vec(), VEC_IGNORE_OFF_PROC_ENTRIES, PETSC_TRUE);
+        }
+
+        auto compute_elem_contribution = [&](const FiniteElement &elem, ElementContribution &c)
+        {
+            // Cell data
+            auto xpts = mesh.get_cell_xpts(elem.cell());
+            auto local_dof = field.map_node_dof(mesh.get_cell_nodes(elem.cell()));
+            auto u = field.get_cell_values(elem.cell());
+            c.cols = field.get_cell_dof(elem.cell());
+            c.rows = owner_computes ? field.get_cell_owned_dof(elem.cell()) : c.cols;
+
+            // Integrate
+            auto elem_matrix = elem.integrate_fe_matrix(xpts, u, mat_type, time);
+            c.vec_values = elem.integrate_fe_vector(xpts, u, vec_type, time).entries();
+
+            // Eliminate the fixed DoF and apply their contribution to the RHS
+            int n_dof = static_cast<int>(c.cols.size());
+            for (int j = 0; j < n_dof; j++)
+            {
+                if (is_fixed[local_dof[j]])
+                {
+                    for (int i = 0; i < n_dof; i++)
+                    {
+                        c.vec_values[i] -= elem_matrix.at(i, j) * fixed_values[local_dof[j]];
+                    }
+                    c.rows[j] = -1;
+                    c.cols[j] = -1;
+                }
+            }
+            c.mat_values = elem_matrix.entries();
+        };
+
+        // The owner of each fixed DoF sets the diagonal and RHS entries
+        auto add_fixed_dof_contribution = [&]()
+        {
+            const auto &dof_im = field.dof_im();
+            int n_vars = field.n_vars();
+            for (int i = 0; i < field.n_dof_owned(); i++)
+            {
+                if (is_fixed[i])
+                {
+                    int dof = dof_im.local_to_global(i / n_vars) * n_vars + i % n_vars;
+                    A.add_values({dof}, {dof}, {diag});
+                    b.add_values({dof}, {diag * fixed_values[i]});
+                }
+            }
+        };
+
+        insert_element_contributions(elems, mesh, &A, &b, compute_elem_contribution, add_fixed_dof_contribution);
+    }
+
+    /// @brief Assemble matrix contributions from elements into a PetscMat, with the fixed DoF eliminated
+    /// @note See assemble_constrained_system
+    /// @param elems The contributing elements
+    /// @param field Corresponding field, which holds the fixed DoF
+    /// @param type Element matrix type, e.g stiffness
+    /// @param mat PetscMat where entries are assembled
+    /// @param time Current solution time
+    /// @param diag Value placed on the diagonal for the fixed DoF
+    inline void assemble_constrained_matrix(const std::vector<std::shared_ptr<FiniteElement>> &elems,
+                                            const mesh::Field &field,
+                                            FEMatrixType type,
+                                            la::petsc::PetscMat &mat,
+                                            Scalar time = 0,
+                                            Scalar diag = 1.0)
+    {
+        // Time the assembly
+        common::Timer timer("Constrained matrix assembly");
+
+        auto &mesh = field.mesh();
+        auto [is_fixed, fixed_values] = get_fixed_dof_mask(field);
+
+        // See assemble_matrix
+        bool owner_computes = mesh.has_ghost_cells();
+        if (owner_computes)
+        {
+            MatSetOption(mat.mat(), MAT_NO_OFF_PROC_ENTRIES, PETSC_TRUE);
+        }
+
+        auto compute_elem_contribution = [&](const FiniteElement &elem, ElementContribution &c)
+        {
+            // Cell data
+            auto xpts = mesh.get_cell_xpts(elem.cell());
+            auto local_dof = field.map_node_dof(mesh.get_cell_nodes(elem.cell()));
+            auto u = field.get_cell_values(elem.cell());
+            c.cols = field.get_cell_dof(elem.cell());
+            c.rows = owner_computes ? field.get_cell_owned_dof(elem.cell()) : c.cols;
+
+            // Integrate, skipping the fixed DoF
+            c.mat_values = elem.integrate_fe_matrix(xpts, u, type, time).entries();
+            for (std::size_t i = 0; i < c.cols.size(); i++)
+            {
+                if (is_fixed[local_dof[i]])
+                {
+                    c.rows[i] = -1;
+                    c.cols[i] = -1;
+                }
+            }
+        };
+
+        // The owner of each fixed DoF sets the diagonal entry
+        auto add_fixed_dof_contribution = [&]()
+        {
+            const auto &dof_im = field.dof_im();
+            int n_vars = field.n_vars();
+            for (int i = 0; i < field.n_dof_owned(); i++)
+            {
+                if (is_fixed[i])
+                {
+                    int dof = dof_im.local_to_global(i / n_vars) * n_vars + i % n_vars;
+                    mat.add_values({dof}, {dof}, {diag});
+                }
+            }
+        };
+
+        insert_element_contributions(elems, mesh, &mat, nullptr, compute_elem_contribution, add_fixed_dof_contribution);
+    }
+
+    /// @brief Assemble vector contributions from elements into a PetscVec, skipping the fixed DoF
+    /// @note No lifting is applied, thus this is intended for elements that do not contribute to the
+    /// system matrix, e.g. boundary loads added to a system from assemble_constrained_system
+    /// @param elems The contributing elements
+    /// @param field Corresponding field, which holds the fixed DoF
+    /// @param type Element vector type, e.g. load
+    /// @param vec PetscVec where entries are assembled
+    /// @param time Current solution time
+    inline void assemble_constrained_vector(const std::vector<std::shared_ptr<FiniteElement>> &elems,
+                                            const mesh::Field &field,
+                                            FEVectorType type,
+                                            la::petsc::PetscVec &vec,
+                                            Scalar time = 0)
+    {
+        // Time the assembly
+        common::Timer timer("Constrained vector assembly");
+
+        auto &mesh = field.mesh();
+        auto [is_fixed, fixed_values] = get_fixed_dof_mask(field);
+
+        // See assemble_vector
+        bool owner_computes = mesh.has_ghost_cells();
+        if (owner_computes)
+        {
+            VecSetOption(vec.vec(), VEC_IGNORE_OFF_PROC_ENTRIES, PETSC_TRUE);
+        }
+
+        auto compute_elem_contribution = [&](const FiniteElement &elem, ElementContribution &c)
+        {
+            // Cell data
+            auto xpts = mesh.get_cell_xpts(elem.cell());
+            auto local_dof = field.map_node_dof(mesh.get_cell_nodes(elem.cell()));
+            auto u = field.get_cell_values(elem.cell());
+            c.rows = owner_computes ? field.get_cell_owned_dof(elem.cell()) : field.get_cell_dof(elem.cell());
+
+            // Integrate, skipping the fixed DoF
+            c.vec_values = elem.integrate_fe_vector(xpts, u, type, time).entries();
+            for (std::size_t i = 0; i < c.rows.size(); i++)
+            {
+                if (is_fixed[local_dof[i]])
+                {
+                    c.rows[i] = -1;
+                }
+            }
+        };
+
+        insert_element_contributions(elems, mesh, nullptr, &vec, compute_elem_contribution, [] {});
+    }
+
+    /// @brief Collect the distinct elements of several load cases, and the load cases each of them belongs to
+    /// @param load_cases The contributing elements of each load case
+    /// @return The distinct elements, and the indices of the load cases of each element
+    inline std::pair<std::vector<std::shared_ptr<FiniteElement>>, std::unordered_map<const FiniteElement *, std::vector<int>>>
+    group_load_case_elements(const std::vector<std::vector<std::shared_ptr<FiniteElement>>> &load_cases)
+    {
+        std::vector<std::shared_ptr<FiniteElement>> elems;
+        std::unordered_map<const FiniteElement *, std::vector<int>> elem_cases;
+        for (std::size_t j = 0; j < load_cases.size(); j++)
+        {
+            for (const auto &elem : load_cases[j])
+            {
+                auto &cases = elem_cases[elem.get()];
+                if (cases.empty())
+                {
+                    elems.push_back(elem);
+                }
+                cases.push_back(static_cast<int>(j));
+            }
+        }
+        return std::make_pair(elems, elem_cases);
+    }
+
+    /// @brief Assemble the vector contributions of several load cases into the columns of a dense PetscMat,
+    /// in a single pass over their elements
+    /// @note Elements shared by several load cases are only integrated once
+    /// @param load_cases The contributing elements of each load case
+    /// @param field Corresponding field
+    /// @param type Element vector type, e.g. load
+    /// @param B Dense PetscMat with one column per load case, where entries are assembled,
+    /// see la::petsc::create_dense_mat
+    /// @param time Current solution time
+    inline void assemble_block_vector(const std::vector<std::vector<std::shared_ptr<FiniteElement>>> &load_cases,
+                                      const mesh::Field &field,
+                                      FEVectorType type,
+                                      la::petsc::PetscMat &B,
+                                      Scalar time = 0)
+    {
+        // Time the assembly
+        common::Timer timer("Block vector assembly");
+
+        auto &mesh = field.mesh();
+        auto [elems, elem_cases] = group_load_case_elements(load_cases);
+
+        // See assemble_vector
+        bool owner_computes = mesh.has_ghost_cells();
+        if (owner_computes)
+        {
+            MatSetOption(B.mat(), MAT_NO_OFF_PROC_ENTRIES, PETSC_TRUE);
+        }
+
+        auto compute_elem_contribution = [&](const FiniteElement &elem, ElementContribution &c)
+        {
+            // Cell data
+            auto xpts = mesh.get_cell_xpts(elem.cell());
+            auto u = field.get_cell_values(elem.cell());
+            c.rows = owner_computes ? field.get_cell_owned_dof(elem.cell()) : field.get_cell_dof(elem.cell());
+            c.cols = elem_cases.at(&elem);
+
+            // Integrate once, and add to the columns of all load cases of the element
+            auto elem_vec = elem.integrate_fe_vector(xpts, u, type, time);
+            c.mat_values.resize(c.rows.size() * c.cols.size());
+            for (std::size_t i = 0; i < c.rows.size(); i++)
+            {
+                std::fill_n(c.mat_values.begin() + i * c.cols.size(), c.cols.size(), elem_vec.at(i, 0));
+            }
+        };
+
+        insert_element_contributions(elems, mesh, &B, nullptr, compute_elem_contribution, [] {});
+    }
+
+    /// @brief Assemble the vector contributions of several load cases into the columns of a dense PetscMat,
+    /// skipping the fixed DoF
+    /// @note See assemble_block_vector and assemble_constrained_vector
+    /// @param load_cases The contributing elements of each load case
+    /// @param field Corresponding field, which holds the fixed DoF
+    /// @param type Element vector type, e.g. load
+    /// @param B Dense PetscMat with one column per load case, where entries are assembled
+    /// @param time Current solution time
+    inline void assemble_constrained_block_vector(const std::vector<std::vector<std::shared_ptr<FiniteElement>>> &load_cases,
+                                                  const mesh::Field &field,
+                                                  FEVectorType type,
+                                                  la::petsc::PetscMat &B,
+                                                  Scalar time = 0)
+    {
+        // Time the assembly
+        common::Timer timer("Constrained block vector assembly");
+
+        auto &mesh = field.mesh();
+        auto [is_fixed, fixed_values] = get_fixed_dof_mask(field);
+        auto [elems, elem_cases] = group_load_case_elements(load_cases);
+
+        // See assemble_vector
+        bool owner_computes = mesh.has_ghost_cells();
+        if (owner_computes)
+        {
+            MatSetOption(B.mat(), MAT_NO_OFF_PROC_ENTRIES, PETSC_TRUE);
+        }
+
+        auto compute_elem_contribution = [&](const FiniteElement &elem, ElementContribution &c)
+        {
+            // Cell data
+            auto xpts = mesh.get_cell_xpts(elem.cell());
+            auto local_dof = field.map_node_dof(mesh.get_cell_nodes(elem.cell()));
+            auto u = field.get_cell_values(elem.cell());
+            c.rows = owner_computes ? field.get_cell_owned_dof(elem.cell()) : field.get_cell_dof(elem.cell());
+            c.cols = elem_cases.at(&elem);
+
+            // Integrate once, skipping the fixed DoF, and add to the columns of all load cases of the element
+            auto elem_vec = elem.integrate_fe_vector(xpts, u, type, time);
+            c.mat_values.resize(c.rows.size() * c.cols.size());
+            for (std::size_t i = 0; i < c.rows.size(); i++)
+            {
+                if (is_fixed[local_dof[i]])
+                {
+                    c.rows[i] = -1;
+                }
+                std::fill_n(c.mat_values.begin() + i * c.cols.size(), c.cols.size(), elem_vec.at(i, 0));
+            }
+        };
+
+        insert_element_contributions(elems, mesh, &B, nullptr, compute_elem_contribution, [] {});
     }
 
     /// @brief Assemble (integrate) a function for the given elements
@@ -91,6 +891,12 @@ namespace sfem::fe
 
         for (const auto &elem : elems)
         {
+            // Ghost cells are integrated by their owner
+            if (field.mesh().is_cell_owned(elem->cell()) == false)
+            {
+                continue;
+            }
+
             // Cell data
             auto xpts = field.mesh().get_cell_xpts(elem->cell());
             auto dof = field.get_cell_dof(elem->cell());
@@ -0,0 +1,477 @@
+#pragma once
+
+#include "assembly.h"
+#include "../basis/basis.h"
+#include "../../la/petsc/petsc_mat.h"
+#include "../../mesh/field.h"
+#include "../../common/math.h"
+#include "../../common/timer.h"
+#include "../../common/logger.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mpi.h>
+
+namespace sfem::fe
+{
+    /// @brief Clamp natural coordinates to the reference domain of a cell type,
+    /// i.e. [-1, 1]^d for lines, quads and hexes, or the unit simplex for triangles and tets
+    /// @param type Cell type
+    /// @param d Reference dimension
+    /// @param xi Natural coordinates, clamped in place
+    inline void clamp_to_reference(mesh::CellType type, int d, Scalar xi[])
+    {
+        if (type == mesh::CellType::triangle || type == mesh::CellType::tet)
+        {
+            Scalar sum = 0;
+            for (int k = 0; k < d; k++)
+            {
+                xi[k] = std::max(xi[k], 0.0);
+                sum += xi[k];
+            }
+            if (sum > 1)
+            {
+                for (int k = 0; k < d; k++)
+                {
+                    xi[k] /= sum;
+                }
+            }
+        }
+        else
+        {
+            for (int k = 0; k < d; k++)
+            {
+                xi[k] = std::clamp(xi[k], -1.0, 1.0);
+            }
+        }
+    }
+
+    /// @brief Find the natural coordinates of a point in a cell, by inverting the cell's isoparametric map
+    /// with Newton's method
+    /// @note If the point lies outside the cell, the natural coordinates are clamped to the reference
+    /// domain, i.e. the returned position is (approximately) the closest point of the cell
+    /// @param basis Basis of the cell
+    /// @param type Cell type
+    /// @param xpts Nodal positions of the cell (3 per node)
+    /// @param x Point
+    /// @param xi Natural coordinates of the point (or of the closest point)
+    /// @return Distance from the point to the cell, i.e. zero if the point lies inside
+    inline Scalar invert_cell_map(const basis::Basis &basis,
+                                  mesh::CellType type,
+                                  const std::vector<Scalar> &xpts,
+                                  const Scalar x[],
+                                  Scalar xi[])
+    {
+        int d = basis.dim();
+        int n_nodes = basis.n_nodes();
+        std::vector<Scalar> N(n_nodes);
+        std::vector<Scalar> dNdxi(n_nodes * 3);
+
+        // Map the natural coordinates to the physical position
+        auto map = [&](const Scalar pt[], Scalar X[])
+        {
+            basis.eval_shape(pt, N.data());
+            std::fill(X, X + 3, 0.0);
+            for (int i = 0; i < n_nodes; i++)
+            {
+                for (int k = 0; k < 3; k++)
+                {
+                    X[k] += N[i] * xpts[i * 3 + k];
+                }
+            }
+        };
+
+        // Start from the centroid of the reference domain
+        bool is_simplex = type == mesh::CellType::triangle || type == mesh::CellType::tet;
+        std::fill(xi, xi + 3, 0.0);
+        for (int k = 0; k < d; k++)
+        {
+            xi[k] = is_simplex ? 1.0 / (d + 1) : 0.0;
+        }
+
+        Scalar X[3];
+        for (int iter = 0; iter < 20; iter++)
+        {
+            // Residual and Jacobian of the map (physical coordinates beyond d are ignored)
+            map(xi, X);
+            basis.eval_shape_grad(xi, dNdxi.data());
+            Scalar J[9] = {0};
+            Scalar r[3] = {0};
+            for (int k = 0; k < d; k++)
+            {
+                r[k] = x[k] - X[k];
+                for (int l = 0; l < d; l++)
+                {
+                    for (int i = 0; i < n_nodes; i++)
+                    {
+                        J[k * d + l] += xpts[i * 3 + k] * dNdxi[i * 3 + l];
+                    }
+                }
+            }
+            if (!math::solve(d, J, r))
+            {
+                break;
+            }
+
+            // Update, keeping the iterate close to the reference domain to avoid divergence
+            Scalar step = 0;
+            for (int k = 0; k < d; k++)
+            {
+                xi[k] = std::clamp(xi[k] + r[k], -3.0, 3.0);
+                step = std::max(step, std::abs(r[k]));
+            }
+            if (step < 1e-12)
+            {
+                break;
+            }
+        }
+
+        clamp_to_reference(type, d, xi);
+        map(xi, X);
+        Scalar dist = 0;
+        for (int k = 0; k < 3; k++)
+        {
+            dist += (x[k] - X[k]) * (x[k] - X[k]);
+        }
+        return std::sqrt(dist);
+    }
+
+    /// @brief Create the interpolation (prolongation) operator between two discretisations of the same domain,
+    /// for use as inter-grid transfer by multigrid methods
+    /// @note The meshes need not be nested, nor share their partitioning: each owned fine node is located
+    /// in a coarse cell, and the coarse shape functions are evaluated there, i.e. P_ij = N_j(x_i) for each
+    /// variable. Fine nodes outside the coarse mesh (e.g. on curved boundaries) are assigned to the closest
+    /// coarse cell. Only the cells of the highest dimension are used
+    /// @note The search is local first, using a uniform bin grid over the local coarse cells. The fine nodes
+    /// not found locally are gathered on all processes, and the process with the closest cell inserts
+    /// their rows
+    /// @note The rows of the fine fixed DoF and the columns of the coarse fixed DoF are zero, consistently
+    /// with operators assembled by assemble_constrained_matrix
+    /// @note Collective
+    /// @param coarse_field Field on the coarse mesh
+    /// @param fine_field Field on the fine mesh, with the same number of variables
+    /// @return The interpolation matrix, of size n_dof_global(fine) x n_dof_global(coarse)
+    inline la::petsc::PetscMat create_interpolation(const mesh::Field &coarse_field, const mesh::Field &fine_field)
+    {
+        // Time the construction
+        common::Timer timer("Interpolation operator");
+
+        int n_vars = coarse_field.n_vars();
+        if (fine_field.n_vars() != n_vars)
+        {
+            error::invalid_size_error(n_vars, fine_field.n_vars(), __FILE__, __LINE__);
+        }
+
+        const auto &coarse = coarse_field.mesh();
+        const auto &fine = fine_field.mesh();
+        int dim = coarse.dim();
+        auto [coarse_is_fixed, coarse_fixed_values] = get_fixed_dof_mask(coarse_field);
+
+        // Coarse cells of the highest dimension, with their bases and bounding boxes
+        std::vector<mesh::Cell> cells;
+        std::vector<std::array<Scalar, 6>> bboxes;
+        std::map<std::pair<mesh::CellType, int>, std::shared_ptr<basis::Basis>> bases;
+        int max_cell_nodes = 0;
+        for (const auto &cell : coarse.cells())
+        {
+            if (cell.dim() != dim)
+            {
+                continue;
+            }
+            auto key = std::make_pair(cell.type(), cell.order());
+            if (bases.count(key) == 0)
+            {
+                bases[key] = std::shared_ptr<basis::Basis>(basis::CreateBasis(cell));
+                if (!bases[key])
+                {
+                    Logger::instance().error("Unsupported cell type or order for interpolation", __FILE__, __LINE__);
+                }
+            }
+            std::array<Scalar, 6> bbox;
+            for (int k = 0; k < 3; k++)
+            {
+                bbox[k] = std::numeric_limits<Scalar>::max();
+                bbox[k + 3] = std::numeric_limits<Scalar>::lowest();
+            }
+            auto xpts = coarse.get_cell_xpts(cell);
+            for (int i = 0; i < cell.n_nodes(); i++)
+            {
+                for (int k = 0; k < 3; k++)
+                {
+                    bbox[k] = std::min(bbox[k], xpts[i * 3 + k]);
+                    bbox[k + 3] = std::max(bbox[k + 3], xpts[i * 3 + k]);
+                }
+            }
+            cells.push_back(cell);
+            bboxes.push_back(bbox);
+            max_cell_nodes = std::max(max_cell_nodes, cell.n_nodes());
+        }
+
+        // Uniform bin grid over the local coarse cells, with about one cell per bin
+        std::array<Scalar, 3> lo = {0, 0, 0};
+        std::array<Scalar, 3> hi = {0, 0, 0};
+        std::array<int, 3> n_bins = {1, 1, 1};
+        Scalar h = 0;
+        if (!cells.empty())
+        {
+            for (int k = 0; k < 3; k++)
+            {
+                lo[k] = std::numeric_limits<Scalar>::max();
+                hi[k] = std::numeric_limits<Scalar>::lowest();
+            }
+            for (const auto &bbox : bboxes)
+            {
+                for (int k = 0; k < 3; k++)
+                {
+                    lo[k] = std::min(lo[k], bbox[k]);
+                    hi[k] = std::max(hi[k], bbox[k + 3]);
+                }
+            }
+            for (int k = 0; k < dim; k++)
+            {
+                h = std::max(h, hi[k] - lo[k]);
+            }
+            int n_per_dim = std::max(1, static_cast<int>(std::pow(static_cast<Scalar>(cells.size()), 1.0 / dim)));
+            for (int k = 0; k < dim; k++)
+            {
+                n_bins[k] = std::max(1, static_cast<int>(std::ceil(n_per_dim * (hi[k] - lo[k]) / h)));
+            }
+        }
+        auto bin_coord = [&](Scalar x, int k)
+        {
+            Scalar w = (hi[k] - lo[k]) / n_bins[k];
+            int b = w > 0 ? static_cast<int>(std::floor((x - lo[k]) / w)) : 0;
+            return std::clamp(b, 0, n_bins[k] - 1);
+        };
+        std::vector<std::vector<int>> bins(n_bins[0] * n_bins[1] * n_bins[2]);
+        for (std::size_t c = 0; c < cells.size(); c++)
+        {
+            std::array<int, 3> b0, b1;
+            for (int k = 0; k < 3; k++)
+            {
+                b0[k] = bin_coord(bboxes[c][k], k);
+                b1[k] = bin_coord(bboxes[c][k + 3], k);
+            }
+            for (int i = b0[0]; i <= b1[0]; i++)
+            {
+                for (int j = b0[1]; j <= b1[1]; j++)
+                {
+                    for (int l = b0[2]; l <= b1[2]; l++)
+                    {
+                        bins[(i * n_bins[1] + j) * n_bins[2] + l].push_back(static_cast<int>(c));
+                    }
+                }
+            }
+        }
+
+        // Find the closest local coarse cell to a point, searching the bins within max_ring of the point's bin.
+        // Returns the position of the cell in cells (-1 if none) and the distance. Points within a small tolerance,
+        // relative to the extent of the local cells, are inside
+        Scalar tol = 1e-12 * h;
+        auto find_cell = [&](const Scalar x[], int max_ring, Scalar xi[])
+        {
+            int best = -1;
+            Scalar best_dist = std::numeric_limits<Scalar>::max();
+            if (cells.empty())
+            {
+                return std::make_pair(best, best_dist);
+            }
+
+            std::array<int, 3> b;
+            for (int k = 0; k < 3; k++)
+            {
+                b[k] = bin_coord(x[k], k);
+            }
+            Scalar pt[3];
+            int found_ring = -1;
+            for (int r = 0; r <= max_ring; r++)
+            {
+                // Stop one ring after the first candidate, or as soon as the point is inside a cell
+                if ((found_ring >= 0 && r > found_ring + 1) || best_dist <= tol)
+                {
+                    break;
+                }
+                bool in_range = false;
+                for (int i = b[0] - r; i <= b[0] + r; i++)
+                {
+                    for (int j = b[1] - r; j <= b[1] + r; j++)
+                    {
+                        for (int l = b[2] - r; l <= b[2] + r; l++)
+                        {
+                            if (i < 0 || j < 0 || l < 0 || i >= n_bins[0] || j >= n_bins[1] || l >= n_bins[2])
+                            {
+                                continue;
+                            }
+                            in_range = true;
+                            // Only the bins on the ring's shell
+                            if (std::max({std::abs(i - b[0]), std::abs(j - b[1]), std::abs(l - b[2])}) != r)
+                            {
+                                continue;
+                            }
+                            for (int c : bins[(i * n_bins[1] + j) * n_bins[2] + l])
+                            {
+                                const auto &cell = cells[c];
+                                auto dist = invert_cell_map(*bases.at({cell.type(), cell.order()}), cell.type(),
+                                                            coarse.get_cell_xpts(cell), x, pt);
+                                if (dist < best_dist)
+                                {
+                                    best = c;
+                                    best_dist = dist;
+                                    std::copy(pt, pt + 3, xi);
+                                }
+                            }
+                        }
+                    }
+                }
+                if (best >= 0 && found_ring < 0)
+                {
+                    found_ring = r;
+                }
+                if (!in_range)
+                {
+                    break;
+                }
+            }
+            return std::make_pair(best, best_dist);
+        };
+
+        // Interpolation matrix, with at most one coarse cell per row
+        const auto &fine_im = fine_field.dof_im();
+        Mat P;
+        MatCreateAIJ(SFEM_COMM_WORLD,
+                     fine_field.n_dof_owned(), coarse_field.n_dof_owned(),
+                     fine_field.n_dof_global(), coarse_field.n_dof_global(),
+                     max_cell_nodes, nullptr, max_cell_nodes, nullptr, &P);
+        MatSetOption(P, MAT_NEW_NONZERO_ALLOCATION_ERR, PETSC_FALSE);
+        la::petsc::PetscMat interp(P, false);
+
+        // Insert the rows of a fine node, located at xi in a coarse cell
+        auto insert_rows = [&](int fine_node, int c, const Scalar xi[])
+        {
+            const auto &cell = cells[c];
+            const auto &basis = *bases.at({cell.type(), cell.order()});
+            std::vector<Scalar> N(basis.n_nodes());
+            basis.eval_shape(xi, N.data());
+            auto local_dof = coarse_field.map_node_dof(coarse.get_cell_nodes(cell));
+            auto cell_dof = coarse_field.get_cell_dof(cell);
+            std::vector<int> cols(basis.n_nodes());
+            for (int v = 0; v < n_vars; v++)
+            {
+                for (int i = 0; i < basis.n_nodes(); i++)
+                {
+                    // Skip the fixed DoF, and the shape functions vanishing at the node (up to round-off),
+                    // e.g. for fine nodes on the coarse cell's boundary
+                    bool skip = coarse_is_fixed[local_dof[i * n_vars + v]] || std::abs(N[i]) < 1e-12;
+                    cols[i] = skip ? -1 : cell_dof[i * n_vars + v];
+                }
+                interp.add_values({fine_node * n_vars + v}, cols, N);
+            }
+        };
+
+        // Local search for the owned fine nodes
+        const auto &fine_xpts = fine.xpts();
+        int n_owned = fine.node_im().n_owned();
+        std::vector<Scalar> missing_xpts;
+        std::vector<int> missing_nodes;
+        Scalar xi[3];
+        for (int i = 0; i < n_owned; i++)
+        {
+            auto [c, dist] = find_cell(&fine_xpts[i * 3], 1, xi);
+            if (c >= 0 && dist <= tol)
+            {
+                insert_rows(fine_im.local_to_global(i), c, xi);
+            }
+            else
+            {
+                missing_xpts.insert(missing_xpts.end(), &fine_xpts[i * 3], &fine_xpts[i * 3] + 3);
+                missing_nodes.push_back(fine_im.local_to_global(i));
+            }
+        }
+
+        // Gather the nodes not found locally on all processes
+        int n_procs = Logger::instance().n_procs();
+        int proc_rank = Logger::instance().proc_rank();
+        int n_missing = static_cast<int>(missing_nodes.size());
+        std::vector<int> counts(n_procs), displs(n_procs, 0);
+        MPI_Allgather(&n_missing, 1, MPI_INT, counts.data(), 1, MPI_INT, SFEM_COMM_WORLD);
+        for (int p = 1; p < n_procs; p++)
+        {
+            displs[p] = displs[p - 1] + counts[p - 1];
+        }
+        int n_missing_global = displs[n_procs - 1] + counts[n_procs - 1];
+        if (n_missing_global > 0)
+        {
+            std::vector<int> all_nodes(n_missing_global);
+            MPI_Allgatherv(missing_nodes.data(), n_missing, MPI_INT,
+                           all_nodes.data(), counts.data(), displs.data(), MPI_INT, SFEM_COMM_WORLD);
+            std::vector<Scalar> all_xpts(n_missing_global * 3);
+            for (int p = 0; p < n_procs; p++)
+            {
+                counts[p] *= 3;
+                displs[p] *= 3;
+            }
+            MPI_Allgatherv(missing_xpts.data(), n_missing * 3, SFEM_MPI_FLOAT,
+                           all_xpts.data(), counts.data(), displs.data(), SFEM_MPI_FLOAT, SFEM_COMM_WORLD);
+
+            // Closest cell on this process, reduced to the closest over all processes. Nodes far from
+            // all local cells are only searched exhaustively if no process has a cell nearby
+            struct DistRank
+            {
+                double dist;
+                int rank;
+            };
+            std::vector<int> found(n_missing_global, -1);
+            std::vector<Scalar> found_xi(n_missing_global * 3);
+            std::vector<DistRank> candidates(n_missing_global);
+            std::vector<DistRank> winners(n_missing_global, {std::numeric_limits<Scalar>::max(), 0});
+            for (int max_ring : {1, std::max({n_bins[0], n_bins[1], n_bins[2]})})
+            {
+                for (int i = 0; i < n_missing_global; i++)
+                {
+                    if (max_ring > 1 && winners[i].dist < std::numeric_limits<Scalar>::max())
+                    {
+                        candidates[i] = winners[i];
+                        continue;
+                    }
+                    auto [c, dist] = find_cell(&all_xpts[i * 3], max_ring, &found_xi[i * 3]);
+                    found[i] = c;
+                    candidates[i] = {dist, proc_rank};
+                }
+                MPI_Allreduce(candidates.data(), winners.data(), n_missing_global, MPI_DOUBLE_INT, MPI_MINLOC,
+                              SFEM_COMM_WORLD);
+                if (std::all_of(winners.cbegin(), winners.cend(), [](const auto &w)
+                                { return w.dist < std::numeric_limits<Scalar>::max(); }))
+                {
+                    break;
+                }
+            }
+
+            // The process with the closest cell inserts the rows
+            for (int i = 0; i < n_missing_global; i++)
+            {
+                if (winners[i].rank == proc_rank && found[i] >= 0)
+                {
+                    insert_rows(all_nodes[i], found[i], &found_xi[i * 3]);
+                }
+            }
+        }
+        interp.assemble();
+
+        // Zero the rows of the fine fixed DoF
+        auto [fine_fixed_dof, fine_fixed_values] = fine_field.get_local_fixed_dof();
+        std::vector<int> fixed_rows;
+        for (auto dof : fine_fixed_dof)
+        {
+            if (dof < fine_field.n_dof_owned())
+            {
+                fixed_rows.push_back(fine_im.local_to_global(dof / n_vars) * n_vars + dof % n_vars);
+            }
+        }
+        MatZeroRows(interp.mat(), fixed_rows.size(), fixed_rows.data(), 0.0, nullptr, nullptr);
+
+        return interp;
+    }
+}
\ No newline at end of file
@@ -4,10 +4,16 @@
 #include "../functions/function.h"
 #include "../../la/petsc/petsc_utils.h"
 #include "../../mesh/field.h"
+#include "../../common/math.h"
+#include <algorithm>
+#include <numeric>
+#include <mpi.h>
 
 namespace sfem::fe
 {
     /// @brief Project a function over the given elements
+    /// @note This is a global L2 projection with the consistent mass matrix, requiring a linear solve.
+    /// See project_function_lumped() and superconvergent_patch_recovery() for cheaper alternatives
     /// @param elems Elements to use for projection
     /// @param field Corresponding field
     /// @param func Function to be projected
@@ -24,18 +30,21 @@ namespace sfem::fe
                                func.size(),
                                field.mesh());
 
-        auto M = la::petsc::create_mat(field.mesh(), 1); // LHS projection/mass matrix
-        std::vector<la::petsc::PetscVec> F;              // RHS vector(s)
-        std::vector<la::petsc::PetscVec> U;              // Solution vector(s)
-        for (int i = 0; i < func.size(); i++)
-        {
-            F.push_back(la::petsc::create_vec(field.mesh(), 1));
-            U.push_back(la::petsc::create_vec(field.mesh(), 1));
-        }
+        auto M = la::petsc::create_mat(field.mesh(), 1);                     // LHS projection/mass matrix
+        auto F = la::petsc::create_dense_mat(field.mesh(), 1, func.size()); // RHS, one column per component
+        auto U = la::petsc::create_dense_mat(field.mesh(), 1, func.size()); // Solution, one column per component
+        std::vector<int> components(func.size());
+        std::iota(components.begin(), components.end(), 0);
 
-        // Assemble the matrix and vector(s)
+        // Assemble the matrix and all RHS in a single pass
         for (const auto &elem : elems)
         {
+            // Ghost cells are integrated by their owner
+            if (field.mesh().is_cell_owned(elem->cell()) == false)
+            {
+                continue;
+            }
+
             auto xpts = field.mesh().get_cell_xpts(elem->cell());
             auto dof = field.dof_im().local_to_global(field.mesh().get_cell_nodes(elem->cell()));
             auto u = field.get_cell_values(elem->cell());
@@ -43,33 +52,394 @@ namespace sfem::fe
             auto [Me, Fe] = elem->project_function(xpts, u, func, time);
 
             M.add_values(dof, Me.entries());
-            for (int i = 0; i < func.size(); i++)
-            {
-                F[i].add_values(dof, Fe.get_col_values(i));
-            }
+            F.add_values(dof, components, Fe.entries());
         }
 
-        // Solve the resulting linear system(s)
+        // Solve for all components at once
         M.assemble();
-        for (int i = 0; i < func.size(); i++)
-        {
-            F[i].assemble();
-            U[i].assemble();
-            la::petsc::solve(M, F[i], U[i]);
-        }
+        F.assemble();
+        U.assemble();
+        la::petsc::PetscKSP solver;
+        solver.set_from_options();
+        solver.set_operator(M.mat());
+        solver.mat_solve(F.mat(), U.mat());
 
-        // Set the projection field's values
+        // Set the projection field's owned values, from the column-major local block, and update the ghosts
+        int n_owned = field.mesh().node_im().n_owned();
         std::vector<Scalar> values(field.mesh().n_nodes_local() * func.size());
+        const Scalar *u_values;
+        MatDenseGetArrayRead(U.mat(), &u_values);
         for (int i = 0; i < func.size(); i++)
         {
-            auto u = U[i].get_values();
-            for (std::size_t j = 0; j < u.size(); j++)
+            for (int j = 0; j < n_owned; j++)
             {
-                values[j * func.size() + i] = u[j];
+                values[j * func.size() + i] = u_values[i * n_owned + j];
             }
         }
+        MatDenseRestoreArrayRead(U.mat(), &u_values);
         projection.set_values(values);
+        projection.update_ghosts();
 
         return projection;
     }
+
+    /// @brief Project a function over the given elements, using the row-sum lumped mass matrix
+    /// @note No global system is assembled or solved: the element contributions are summed at the
+    /// nodes and divided by the lumped nodal masses
+    /// @note Row-sum lumping may lead to zero or negative nodal masses for some higher order
+    /// elements (e.g. quadratic triangles and tets), in which case the consistent projection
+    /// should be used instead
+    /// @param elems Elements to use for projection
+    /// @param field Corresponding field
+    /// @param func Function to be projected
+    /// @param time Current solution time
+    /// @return The projected field
+    inline mesh::Field project_function_lumped(const std::vector<std::shared_ptr<FiniteElement>> &elems,
+                                               const mesh::Field &field,
+                                               const Function &func,
+                                               Scalar time = 0)
+    {
+        auto &mesh = field.mesh();
+        int size = func.size();
+
+        // Resulting field and lumped nodal masses
+        mesh::Field projection("Projection", size, mesh);
+        mesh::Field mass("Mass", 1, mesh);
+        auto &values = projection.values();
+        auto &masses = mass.values();
+
+        for (const auto &elem : elems)
+        {
+            // Ghost cells are integrated by their owner
+            if (mesh.is_cell_owned(elem->cell()) == false)
+            {
+                continue;
+            }
+
+            auto xpts = mesh.get_cell_xpts(elem->cell());
+            auto nodes = mesh.get_cell_nodes(elem->cell());
+            auto u = field.get_cell_values(elem->cell());
+
+            auto [Me, Fe] = elem->project_function(xpts, u, func, time);
+
+            for (std::size_t i = 0; i < nodes.size(); i++)
+            {
+                for (std::size_t j = 0; j < nodes.size(); j++)
+                {
+                    masses[nodes[i]] += Me.at(i, j);
+                }
+                for (int j = 0; j < size; j++)
+                {
+                    values[nodes[i] * size + j] += Fe.at(i, j);
+                }
+            }
+        }
+
+        // Sum the contributions to the ghost nodes to their owners
+        projection.accumulate_ghosts();
+        mass.accumulate_ghosts();
+
+        // Nodes which are not part of any element are left at zero
+        for (int i = 0; i < mesh.node_im().n_owned(); i++)
+        {
+            if (masses[i] == 0)
+            {
+                continue;
+            }
+            for (int j = 0; j < size; j++)
+            {
+                values[i * size + j] /= masses[i];
+            }
+        }
+        projection.update_ghosts();
+
+        return projection;
+    }
+
+    /// @brief Recover nodal values of a function over the given elements, using the superconvergent
+    /// patch recovery (SPR) of Zienkiewicz and Zhu
+    /// @note For each owned node, a polynomial is fitted, in the least-squares sense, to the function
+    /// values at the quadrature points of the patch of elements around the node. The polynomial is
+    /// evaluated at all nodes of the patch, and the values of overlapping patches are averaged
+    /// @note The polynomial is complete, of the same degree as the cells (at most quadratic). Patches
+    /// with too few quadrature points for a unique fit (e.g. corner nodes) are skipped, and the nodes
+    /// not covered by any patch take the lumped projection values
+    /// @note For partitioned meshes, a layer of ghost cells is required for complete patches along the
+    /// partition interfaces
+    /// @param elems Elements to use for recovery
+    /// @param field Corresponding field
+    /// @param func Function to be recovered
+    /// @param time Current solution time
+    /// @return The recovered field
+    inline mesh::Field superconvergent_patch_recovery(const std::vector<std::shared_ptr<FiniteElement>> &elems,
+                                                      const mesh::Field &field,
+                                                      const Function &func,
+                                                      Scalar time = 0)
+    {
+        auto &mesh = field.mesh();
+        int size = func.size();
+        int dim = mesh.dim();
+        int n_owned = mesh.node_im().n_owned();
+
+        // Element-to-node connectivity, and its inverse, i.e. the node patches
+        mesh::Connectivity elem_node_conn;
+        elem_node_conn.n1 = static_cast<int>(elems.size());
+        elem_node_conn.n2 = mesh.n_nodes_local();
+        std::vector<std::vector<int>> elem_nodes(elems.size());
+        for (std::size_t i = 0; i < elems.size(); i++)
+        {
+            elem_nodes[i] = mesh.get_cell_nodes(elems[i]->cell());
+            elem_node_conn.ptr.push_back(static_cast<int>(elem_node_conn.idx.size()));
+            elem_node_conn.cnt.push_back(static_cast<int>(elem_nodes[i].size()));
+            elem_node_conn.idx.insert(elem_node_conn.idx.end(), elem_nodes[i].begin(), elem_nodes[i].end());
+        }
+        auto node_elem_conn = mesh::invert_conn(elem_node_conn);
+
+        // Function values and physical coordinates at the quadrature points, per element
+        std::vector<std::vector<Scalar>> qpt_xpts(elems.size());
+        std::vector<std::vector<Scalar>> qpt_values(elems.size());
+        for (std::size_t i = 0; i < elems.size(); i++)
+        {
+            const auto &elem = elems[i];
+            auto xpts = mesh.get_cell_xpts(elem->cell());
+            auto u = field.get_cell_values(elem->cell());
+            for (int npt = 0; npt < elem->basis()->n_qpts(); npt++)
+            {
+                auto data = elem->transform_basis(npt, xpts);
+                auto values = func(*elem, data, xpts, u, time);
+                for (int k = 0; k < 3; k++)
+                {
+                    Scalar x = 0;
+                    for (std::size_t j = 0; j < data.N.size(); j++)
+                    {
+                        x += data.N[j] * xpts[j * 3 + k];
+                    }
+                    qpt_xpts[i].push_back(x);
+                }
+                for (int j = 0; j < size; j++)
+                {
+                    qpt_values[i].push_back(values.at(j, 0));
+                }
+            }
+        }
+
+        // Complete polynomial basis up to the given degree, in coordinates relative to the patch node,
+        // scaled by the patch size
+        auto eval_monomials = [dim](int degree, const Scalar x[], Scalar p[])
+        {
+            int n = 0;
+            p[n++] = 1;
+            for (int d = 1; d <= degree; d++)
+            {
+                if (d == 1)
+                {
+                    for (int k = 0; k < dim; k++)
+                    {
+                        p[n++] = x[k];
+                    }
+                }
+                else
+                {
+                    for (int k = 0; k < dim; k++)
+                    {
+                        for (int l = k; l < dim; l++)
+                        {
+                            p[n++] = x[k] * x[l];
+                        }
+                    }
+                }
+            }
+            return n;
+        };
+
+        // Sums of the patch evaluations at the nodes, and their number
+        mesh::Field recovery("Recovery", size, mesh);
+        mesh::Field counts("Counts", 1, mesh);
+        auto &values = recovery.values();
+        auto &n_evals = counts.values();
+
+        const auto &xpts = mesh.xpts();
+        for (int node = 0; node < n_owned; node++)
+        {
+            int n_patch_elems = node_elem_conn.cnt[node];
+            if (n_patch_elems == 0)
+            {
+                continue;
+            }
+
+            // Patch nodes, quadrature points and polynomial degree
+            std::vector<int> patch_nodes;
+            int n_samples = 0;
+            int degree = 2;
+            for (int j = 0; j < n_patch_elems; j++)
+            {
+                int e = node_elem_conn.idx[node_elem_conn.ptr[node] + j];
+                patch_nodes.insert(patch_nodes.end(), elem_nodes[e].begin(), elem_nodes[e].end());
+                n_samples += static_cast<int>(qpt_xpts[e].size()) / 3;
+                degree = std::min(degree, elems[e]->cell().order());
+            }
+            std::sort(patch_nodes.begin(), patch_nodes.end());
+            patch_nodes.erase(std::unique(patch_nodes.begin(), patch_nodes.end()), patch_nodes.end());
+
+            Scalar x0[3] = {xpts[node * 3 + 0], xpts[node * 3 + 1], xpts[node * 3 + 2]};
+            Scalar h = 0;
+            for (auto patch_node : patch_nodes)
+            {
+                for (int k = 0; k < 3; k++)
+                {
+                    h = std::max(h, std::abs(xpts[patch_node * 3 + k] - x0[k]));
+                }
+            }
+
+            Scalar p[10];
+            int n_terms = eval_monomials(degree, x0, p);
+            if (n_samples < n_terms || h == 0)
+            {
+                continue;
+            }
+
+            // Normal equations of the least-squares fit, for all components at once
+            std::vector<Scalar> A(n_terms * n_terms, 0);
+            std::vector<Scalar> B(n_terms * size, 0);
+            for (int j = 0; j < n_patch_elems; j++)
+            {
+                int e = node_elem_conn.idx[node_elem_conn.ptr[node] + j];
+                for (std::size_t q = 0; q < qpt_xpts[e].size() / 3; q++)
+                {
+                    Scalar x[3];
+                    for (int k = 0; k < 3; k++)
+                    {
+                        x[k] = (qpt_xpts[e][q * 3 + k] - x0[k]) / h;
+                    }
+                    eval_monomials(degree, x, p);
+                    for (int k = 0; k < n_terms; k++)
+                    {
+                        for (int l = 0; l < n_terms; l++)
+                        {
+                            A[k * n_terms + l] += p[k] * p[l];
+                        }
+                        for (int l = 0; l < size; l++)
+                        {
+                            B[l * n_terms + k] += p[k] * qpt_values[e][q * size + l];
+                        }
+                    }
+                }
+            }
+
+            // Solve for each component, skipping degenerate patches
+            std::vector<Scalar> coeffs = B;
+            bool is_solved = true;
+            for (int l = 0; l < size && is_solved; l++)
+            {
+                std::vector<Scalar> Al = A;
+                is_solved = math::solve(n_terms, Al.data(), &coeffs[l * n_terms]);
+            }
+            if (is_solved == false)
+            {
+                continue;
+            }
+
+            // Evaluate the fitted polynomial at the patch nodes
+            for (auto patch_node : patch_nodes)
+            {
+                Scalar x[3];
+                for (int k = 0; k < 3; k++)
+                {
+                    x[k] = (xpts[patch_node * 3 + k] - x0[k]) / h;
+                }
+                eval_monomials(degree, x, p);
+                for (int l = 0; l < size; l++)
+                {
+                    for (int k = 0; k < n_terms; k++)
+                    {
+                        values[patch_node * size + l] += coeffs[l * n_terms + k] * p[k];
+                    }
+                }
+                n_evals[patch_node] += 1;
+            }
+        }
+
+        // Sum the evaluations at the ghost nodes to their owners, and average
+        recovery.accumulate_ghosts();
+        counts.accumulate_ghosts();
+
+        int n_missing = 0;
+        for (int i = 0; i < n_owned; i++)
+        {
+            if (n_evals[i] == 0)
+            {
+                n_missing++;
+                continue;
+            }
+            for (int j = 0; j < size; j++)
+            {
+                values[i * size + j] /= n_evals[i];
+            }
+        }
+
+        // Nodes not covered by any patch
+        int n_missing_global;
+        MPI_Allreduce(&n_missing, &n_missing_global, 1, MPI_INT, MPI_SUM, SFEM_COMM_WORLD);
+        if (n_missing_global > 0)
+        {
+            auto lumped = project_function_lumped(elems, field, func, time);
+            for (int i = 0; i < n_owned; i++)
+            {
+                if (n_evals[i] == 0)
+                {
+                    for (int j = 0; j < size; j++)
+                    {
+                        values[i * size + j] = lumped.values()[i * size + j];
+                    }
+                }
+            }
+        }
+        recovery.update_ghosts();
+
+        return recovery;
+    }
+
+    /// @brief Evaluate the volume-averaged values of a function over each of the given elements
+    /// @note The values are ordered by local cell index, i.e. the values of a cell are stored at
+    /// mesh.cell_im().global_to_local(cell.idx()) * func.size(). Cells without elements are left at zero
+    /// @note The values are suitable for VTK output as cell data, without any nodal projection
+    /// @param elems Elements to evaluate
+    /// @param field Corresponding field
+    /// @param func Function to be evaluated
+    /// @param time Current solution time
+    /// @return The cell values
+    inline std::vector<Scalar> evaluate_cell_averages(const std::vector<std::shared_ptr<FiniteElement>> &elems,
+                                                      const mesh::Field &field,
+                                                      const Function &func,
+                                                      Scalar time = 0)
+    {
+        auto &mesh = field.mesh();
+        int size = func.size();
+
+        std::vector<Scalar> cell_values(mesh.n_cells_local() * size, 0);
+        for (const auto &elem : elems)
+        {
+            auto xpts = mesh.get_cell_xpts(elem->cell());
+            auto u = field.get_cell_values(elem->cell());
+            int cell = mesh.cell_im().global_to_local(elem->cell().idx());
+
+            Scalar volume = 0;
+            for (int npt = 0; npt < elem->basis()->n_qpts(); npt++)
+            {
+                auto data = elem->transform_basis(npt, xpts);
+                auto values = func(*elem, data, xpts, u, time);
+                volume += data.detJ * data.qwt;
+                for (int j = 0; j < size; j++)
+                {
+                    cell_values[cell * size + j] += values.at(j, 0) * data.detJ * data.qwt;
+                }
+            }
+            for (int j = 0; j < size; j++)
+            {
+                cell_values[cell * size + j] /= volume;
+            }
+        }
+
+        return cell_values;
+    }
 }
\ No newline at end of file
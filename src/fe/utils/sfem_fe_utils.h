@@ -1,4 +1,5 @@
 #pragma once
 
 #include "assembly.h"
-#include "project_function.h"
\ No newline at end of file
+#include "project_function.h"
+#include "grid_transfer.h"
\ No newline at end of file
@@ -138,6 +138,39 @@ namespace sfem::io
             }
         }
 
+        // For distributed meshes, order the cells according to their local index,
+        // since ghost cells (if any) follow the owned cells
+        if (distributed)
+        {
+            std::vector<int> order(n_cells_local);
+            for (int i = 0; i < n_cells_local; i++)
+            {
+                order[cell_im.global_to_local(cells[i].idx())] = i;
+            }
+
+            std::vector<mesh::Cell> cells_ordered;
+            cells_ordered.reserve(n_cells_local);
+            mesh::Connectivity conn_ordered;
+            conn_ordered.n1 = conn.n1;
+            conn_ordered.n2 = conn.n2;
+            conn_ordered.ptr.resize(n_cells_local);
+            conn_ordered.cnt.resize(n_cells_local);
+            conn_ordered.idx.reserve(conn_size_local);
+            for (int i = 0; i < n_cells_local; i++)
+            {
+                int j = order[i];
+                cells_ordered.push_back(cells[j]);
+                conn_ordered.ptr[i] = static_cast<int>(conn_ordered.idx.size());
+                conn_ordered.cnt[i] = conn.cnt[j];
+                for (int k = 0; k < conn.cnt[j]; k++)
+                {
+                    conn_ordered.idx.push_back(conn.idx[conn.ptr[j] + k]);
+                }
+            }
+            cells = std::move(cells_ordered);
+            conn = std::move(conn_ordered);
+        }
+
         return std::make_pair(cells, conn);
     }
     //=============================================================================
@@ -221,7 +254,7 @@ namespace sfem::io
         return regions;
     }
     //=============================================================================
-    mesh::Mesh read_mesh(const std::string &dir, const std::string &partitioner_type)
+    mesh::Mesh read_mesh(const std::string &dir, const std::string &partitioner_type, bool ghost_cells)
     {
         int n_procs = Logger::instance().n_procs();
         bool distributed = false;
@@ -233,7 +266,7 @@ namespace sfem::io
         {
             distributed = true;
             auto [_, conn] = read_cells(dir + "/cells", false, common::IndexMap(0), common::IndexMap(0));
-            auto partitioner = mesh::create_partitioner(partitioner_type, n_procs, conn);
+            auto partitioner = mesh::create_partitioner(partitioner_type, n_procs, conn, ghost_cells);
             std::tie(cell_im, node_im) = partitioner->part_mesh();
             delete partitioner;
         }
@@ -29,8 +29,10 @@ namespace sfem::io
     /// @note For distributed meshes, the mesh is first partitioned
     /// @param dir Directory in which the mesh files are located
     /// @param partitioner_type Type of MeshPartitioner to be used. Defaults to "METIS"
+    /// @param ghost_cells Whether each process also stores a layer of ghost cells,
+    /// i.e. the cells owned by other processes that contain a node owned by this process
     /// @return The portion of the mesh corresponding to this process
-    mesh::Mesh read_mesh(const std::string &dir, const std::string &partitioner_type = "METIS");
+    mesh::Mesh read_mesh(const std::string &dir, const std::string &partitioner_type = "METIS", bool ghost_cells = false);
 
     /// @brief
     /// @param path
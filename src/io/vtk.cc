@@ -4,6 +4,12 @@ namespace sfem::io
 {
     //=============================================================================
     void write_vtk(const std::string &path, const mesh::Mesh &mesh, const std::vector<mesh::Field> &fields)
+    {
+        write_vtk(path, mesh, fields, {});
+    }
+    //=============================================================================
+    void write_vtk(const std::string &path, const mesh::Mesh &mesh, const std::vector<mesh::Field> &fields,
+                   const std::vector<CellData> &cell_data)
     {
         std::ofstream file(path);
         if (!file.is_open())
@@ -25,10 +31,17 @@ namespace sfem::io
             file << xpts[i * 3 + 0] << " " << xpts[i * 3 + 1] << " " << xpts[i * 3 + 2] << "\n";
         }
 
-        // Cells
-        const auto &cells = mesh.cells();
-        const auto &conn = mesh.cell_node_conn();
-        int vtk_size = conn.idx.size() + cells.size();
+        // Cells. Ghost cells are written by their owner, so that partitioned output does not overlap
+        std::vector<mesh::Cell> cells;
+        int vtk_size = 0;
+        for (const auto &cell : mesh.cells())
+        {
+            if (mesh.is_cell_owned(cell))
+            {
+                cells.push_back(cell);
+                vtk_size += cell.n_nodes() + 1;
+            }
+        }
         file << "CELLS " << cells.size() << " " << vtk_size << "\n";
         for (const auto &cell : cells)
         {
@@ -69,5 +82,29 @@ namespace sfem::io
                 }
             }
         }
+
+        // Cell values
+        if (cell_data.size() > 0)
+        {
+            file << "CELL_DATA " << cells.size() << "\n";
+            for (const auto &data : cell_data)
+            {
+                if (static_cast<int>(data.values.size()) != mesh.n_cells_local() * data.n_comps)
+                {
+                    error::invalid_size_error(mesh.n_cells_local() * data.n_comps, data.values.size(), __FILE__, __LINE__);
+                }
+                for (int j = 0; j < data.n_comps; j++)
+                {
+                    std::string name = data.n_comps == 1 ? data.name : data.name + "_" + std::to_string(j);
+                    file << "SCALARS " << name << " float\n";
+                    file << "LOOKUP_TABLE default\n";
+                    for (const auto &cell : cells)
+                    {
+                        int i = mesh.cell_im().global_to_local(cell.idx());
+                        file << data.values[i * data.n_comps + j] << "\n";
+                    }
+                }
+            }
+        }
     }
 }
\ No newline at end of file
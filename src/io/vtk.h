@@ -5,10 +5,28 @@
 
 namespace sfem::io
 {
+    /// @brief Values defined per cell, e.g. element averages of stresses
+    struct CellData
+    {
+        /// @brief Name
+        std::string name;
+
+        /// @brief Number of components
+        int n_comps = 1;
+
+        /// @brief Values, ordered by local cell index, i.e. of size mesh.n_cells_local() * n_comps
+        std::vector<Scalar> values;
+    };
+
     /// @brief Creates .vtk file for the given Mesh and Fields
     /// @note This function will create a file for each process that runs it.
     /// Therefore for each partition a separate file is created.
     void write_vtk(const std::string &path, const mesh::Mesh &mesh, const std::vector<mesh::Field> &fields);
+
+    /// @brief Creates .vtk file for the given Mesh, Fields and cell data
+    /// @note See write_vtk(). Only the values of the owned cells are written
+    void write_vtk(const std::string &path, const mesh::Mesh &mesh, const std::vector<mesh::Field> &fields,
+                   const std::vector<CellData> &cell_data);
 }
 
 namespace sfem::io::vtk
@@ -27,7 +27,13 @@ namespace sfem::la::petsc
     PetscKSP::PetscKSP(PetscKSP &&other)
     {
         ksp_ = other.ksp_;
+        A_ = other.A_;
+        state_ = other.state_;
+        nonzero_state_ = other.nonzero_state_;
+        reuse_preconditioner_ = other.reuse_preconditioner_;
+        n_setups_ = other.n_setups_;
         other.ksp_ = nullptr;
+        other.A_ = nullptr;
     }
     //=============================================================================
     PetscKSP &PetscKSP::operator=(PetscKSP &&other)
@@ -39,7 +45,13 @@ namespace sfem::la::petsc
                 KSPDestroy(&ksp_);
             }
             ksp_ = other.ksp_;
+            A_ = other.A_;
+            state_ = other.state_;
+            nonzero_state_ = other.nonzero_state_;
+            reuse_preconditioner_ = other.reuse_preconditioner_;
+            n_setups_ = other.n_setups_;
             other.ksp_ = nullptr;
+            other.A_ = nullptr;
         }
 
         return *this;
@@ -68,17 +80,87 @@ namespace sfem::la::petsc
         KSPSetOptionsPrefix(ksp_, prefix.c_str());
     }
     //=============================================================================
-    void PetscKSP::set_operator(const Mat A) const
+    void PetscKSP::set_operator(const Mat A)
     {
+        // A new operator always requires a preconditioner setup
+        if (A != A_)
+        {
+            state_ = -1;
+            nonzero_state_ = -1;
+        }
+        A_ = A;
         KSPSetOperators(ksp_, A, A);
     }
     //=============================================================================
-    int PetscKSP::solve(const Vec b, Vec x) const
+    void PetscKSP::set_tolerances(Scalar rtol, Scalar atol, int max_iter) const
+    {
+        KSPSetTolerances(ksp_, rtol, atol, PETSC_DEFAULT, max_iter);
+    }
+    //=============================================================================
+    void PetscKSP::set_reuse_preconditioner(bool flag)
+    {
+        reuse_preconditioner_ = flag;
+        KSPSetReusePreconditioner(ksp_, flag ? PETSC_TRUE : PETSC_FALSE);
+    }
+    //=============================================================================
+    bool PetscKSP::is_operator_modified() const
+    {
+        if (!A_)
+        {
+            return false;
+        }
+        PetscObjectState state, nonzero_state;
+        PetscObjectStateGet((PetscObject)A_, &state);
+        MatGetNonzeroState(A_, &nonzero_state);
+        return state != state_ || nonzero_state != nonzero_state_;
+    }
+    //=============================================================================
+    int PetscKSP::n_setups() const
+    {
+        return n_setups_;
+    }
+    //=============================================================================
+    int PetscKSP::solve(const Vec b, Vec x)
     {
         common::Timer timer("PetscKSP");
 
+        setup();
         KSPSolve(ksp_, b, x);
 
+        return check_convergence();
+    }
+    //=============================================================================
+    int PetscKSP::mat_solve(const Mat B, Mat X)
+    {
+        common::Timer timer("PetscKSP");
+
+        setup();
+        KSPMatSolve(ksp_, B, X);
+
+        return check_convergence();
+    }
+    //=============================================================================
+    void PetscKSP::setup()
+    {
+        if (!A_)
+        {
+            Logger::instance().error("PetscKSP operator has not been set", __FILE__, __LINE__);
+        }
+
+        // Keep track of the preconditioner setups, which PETSc performs when the operator
+        // state has changed, unless the preconditioner is reused
+        if (is_operator_modified() && (n_setups_ == 0 || !reuse_preconditioner_))
+        {
+            common::Timer timer("PetscKSP setup");
+            KSPSetUp(ksp_);
+            PetscObjectStateGet((PetscObject)A_, &state_);
+            MatGetNonzeroState(A_, &nonzero_state_);
+            n_setups_++;
+        }
+    }
+    //=============================================================================
+    int PetscKSP::check_convergence() const
+    {
         // Get the number of iterations the KSP performed
         PetscInt n_iter;
         KSPGetIterationNumber(ksp_, &n_iter);
@@ -8,6 +8,10 @@
 namespace sfem::la::petsc
 {
     /// @brief Thin wrapper around the PETSc linear solvers
+    /// @note The solver is meant to be kept alive across solves: the preconditioner (or factorisation)
+    /// is only rebuilt when the operator values or non-zero pattern have changed since the last setup,
+    /// or never if the preconditioner is set to be reused. Thus, repeated solves with the same operator
+    /// only cost the Krylov iterations
     class PetscKSP
     {
     public:
@@ -44,13 +48,60 @@ namespace sfem::la::petsc
         void set_options_prefix(const std::string &prefix) const;
 
         /// @brief Set the linear system LHS
-        void set_operator(const Mat A) const;
+        /// @note Setting the same operator again is cheap, i.e. the preconditioner is only rebuilt
+        /// by the next solve if the operator has been modified in the meantime
+        void set_operator(const Mat A);
+
+        /// @brief Set the convergence tolerances
+        /// @param rtol Relative tolerance on the residual norm
+        /// @param atol Absolute tolerance on the residual norm
+        /// @param max_iter Maximum number of iterations
+        void set_tolerances(Scalar rtol, Scalar atol, int max_iter) const;
+
+        /// @brief Whether to keep the current preconditioner, even if the operator is modified,
+        /// e.g. for slowly varying operators
+        /// @note The preconditioner is still built on the first solve
+        void set_reuse_preconditioner(bool flag);
+
+        /// @brief Whether the operator has been modified since the preconditioner was last built
+        bool is_operator_modified() const;
+
+        /// @brief Get the number of times the preconditioner has been built
+        int n_setups() const;
 
         /// @brief Solve the linear system Ax=b using the KSP
-        int solve(const Vec b, Vec x) const;
+        int solve(const Vec b, Vec x);
+
+        /// @brief Solve the linear systems AX=B for several right-hand sides at once
+        /// @note The preconditioner application and the operator traversal are shared by all right-hand
+        /// sides, i.e. block Krylov methods are used where available (e.g. -ksp_type cg or hpddm), and
+        /// otherwise the columns are solved one after another with the same preconditioner
+        /// @param B Dense matrix holding the right-hand sides, one per column
+        /// @param X Dense matrix where the solutions are stored, also used as initial guess
+        /// @return Number of iterations performed
+        int mat_solve(const Mat B, Mat X);
 
     private:
+        /// @brief Build the preconditioner, if the operator has been modified since the last setup
+        void setup();
+
+        /// @brief Get the number of iterations of the last solve, and warn if it did not converge
+        int check_convergence() const;
+
         KSP ksp_;
+
+        /// @brief Current operator
+        Mat A_ = nullptr;
+
+        /// @brief State and non-zero state of the operator when the preconditioner was last built
+        PetscObjectState state_ = -1;
+        PetscObjectState nonzero_state_ = -1;
+
+        /// @brief Whether the preconditioner is reused regardless of the operator changes
+        bool reuse_preconditioner_ = false;
+
+        /// @brief Number of times the preconditioner has been built
+        int n_setups_ = 0;
     };
 }
 
@@ -4,16 +4,23 @@
 namespace sfem::la::petsc
 {
     //=============================================================================
-    PetscMat::PetscMat(const std::vector<int> &diag_nnz, const std::vector<int> &off_diag_nnz)
+    PetscMat::PetscMat(const std::vector<int> &diag_nnz, const std::vector<int> &off_diag_nnz, int block_size)
     {
-        MatCreateAIJ(SFEM_COMM_WORLD,
-                     diag_nnz.size(), diag_nnz.size(),
-                     PETSC_DECIDE, PETSC_DECIDE,
-                     PETSC_DECIDE, diag_nnz.data(),
-                     PETSC_DECIDE, off_diag_nnz.data(),
-                     &mat_);
+        if (block_size < 1 || diag_nnz.size() % block_size != 0)
+        {
+            Logger::instance().error("Invalid block size " + std::to_string(block_size), __FILE__, __LINE__);
+        }
 
+        // The block size must be set before the preallocation
+        MatCreate(SFEM_COMM_WORLD, &mat_);
+        MatSetSizes(mat_, diag_nnz.size(), diag_nnz.size(), PETSC_DETERMINE, PETSC_DETERMINE);
+        MatSetBlockSize(mat_, block_size);
+        MatSetType(mat_, MATAIJ);
         MatSetFromOptions(mat_);
+
+        // Only the call matching the actual matrix type has an effect
+        MatSeqAIJSetPreallocation(mat_, PETSC_DECIDE, diag_nnz.data());
+        MatMPIAIJSetPreallocation(mat_, PETSC_DECIDE, diag_nnz.data(), PETSC_DECIDE, off_diag_nnz.data());
     }
     //=============================================================================
     PetscMat::PetscMat(Mat mat, bool inc_ref_count)
@@ -88,9 +95,27 @@ namespace sfem::la::petsc
                      values.data(), ADD_VALUES);
     }
     //=============================================================================
+    void PetscMat::add_values(const std::vector<int> &rows, const std::vector<int> &cols, const std::vector<Scalar> &values)
+    {
+        MatSetValues(mat_,
+                     rows.size(), rows.data(),
+                     cols.size(), cols.data(),
+                     values.data(), ADD_VALUES);
+    }
+    //=============================================================================
     void PetscMat::assemble()
     {
-        MatAssemblyBegin(mat_, MAT_FINAL_ASSEMBLY);
-        MatAssemblyEnd(mat_, MAT_FINAL_ASSEMBLY);
+        assemble_begin();
+        assemble_end();
+    }
+    //=============================================================================
+    void PetscMat::assemble_begin(MatAssemblyType type)
+    {
+        MatAssemblyBegin(mat_, type);
+    }
+    //=============================================================================
+    void PetscMat::assemble_end(MatAssemblyType type)
+    {
+        MatAssemblyEnd(mat_, type);
     }
 }
\ No newline at end of file
@@ -15,7 +15,9 @@ namespace sfem::la::petsc
         /// @brief Create a PetscMat
         /// @param diag_nnz Number of non-zeros for rows on the diagonal
         /// @param off_diag_nnz Number of non-zeros for rows on the off-diagonal
-        PetscMat(const std::vector<int> &diag_nnz, const std::vector<int> &off_diag_nnz);
+        /// @param block_size Block size, i.e. number of variables per node. Used by some
+        /// preconditioners, e.g. algebraic multigrid, to keep the variables of a node together
+        PetscMat(const std::vector<int> &diag_nnz, const std::vector<int> &off_diag_nnz, int block_size = 1);
 
         /// @brief Create a PetscMat from an existing PETSc Mat
         /// @param A Existing PETSc Mat
@@ -55,9 +57,25 @@ namespace sfem::la::petsc
         /// @param values Values
         void add_values(const std::vector<int> &idxs, const std::vector<Scalar> &values);
 
+        /// @brief Add values to the matrix
+        /// @note Negative row or column indices are ignored
+        /// @param rows Row indices
+        /// @param cols Column indices
+        /// @param values Values, stored row-wise
+        void add_values(const std::vector<int> &rows, const std::vector<int> &cols, const std::vector<Scalar> &values);
+
         /// @brief Assemble the matrix
         void assemble();
 
+        /// @brief Start assembling the matrix, i.e. start communicating off-process entries
+        /// @note No values may be added until assemble_end is called
+        /// @param type Assembly type. Use MAT_FLUSH_ASSEMBLY if more values are added afterwards
+        void assemble_begin(MatAssemblyType type = MAT_FINAL_ASSEMBLY);
+
+        /// @brief Complete an assembly started by assemble_begin
+        /// @param type Assembly type, as passed to assemble_begin
+        void assemble_end(MatAssemblyType type = MAT_FINAL_ASSEMBLY);
+
     private:
         /// @brief Underlying PETSc Mat
         Mat mat_;
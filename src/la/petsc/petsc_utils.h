@@ -4,6 +4,9 @@
 #include "petsc_mat.h"
 #include "petsc_ksp.h"
 #include "../sparsity_pattern.h"
+#include "../../mesh/field.h"
+#include "../../common/error.h"
+#include "../../common/logger.h"
 
 namespace sfem::la::petsc
 {
@@ -26,10 +29,69 @@ namespace sfem::la::petsc
     }
 
     /// @brief Create a PetscMat for a given mesh and number of variables per node
+    /// @note The block size of the matrix is set to the number of variables per node
     inline PetscMat create_mat(const mesh::Mesh &mesh, int n_vars)
     {
         auto [diag_nnz, off_diag_nnz] = sparsity_pattern(mesh, n_vars);
-        return PetscMat(diag_nnz, off_diag_nnz);
+        return PetscMat(diag_nnz, off_diag_nnz, n_vars);
+    }
+
+    /// @brief Attach the rigid body modes of a displacement field to a PetscMat as its near null space,
+    /// i.e. 2 translations and 1 rotation in 2D, or 3 translations and 3 rotations in 3D
+    /// @note Used by algebraic multigrid preconditioners (e.g. -pc_type gamg) to build the coarse spaces,
+    /// which considerably improves their convergence for elasticity problems
+    /// @param A The matrix, e.g. the stiffness matrix created by create_mat for the field
+    /// @param field The displacement field, with as many variables per node as the mesh dimension
+    inline void set_rigid_body_modes(PetscMat &A, const mesh::Field &field)
+    {
+        const auto &mesh = field.mesh();
+        int dim = mesh.dim();
+        if (field.n_vars() != dim || dim < 2)
+        {
+            Logger::instance().error("Rigid body modes require a displacement field with " + std::to_string(dim) +
+                                         " variables per node, got " + std::to_string(field.n_vars()),
+                                     __FILE__, __LINE__);
+        }
+
+        // Coordinates of the owned nodes, interlaced with the matrix block size
+        int n_owned = mesh.node_im().n_owned();
+        const auto &xpts = mesh.xpts();
+        Vec coords;
+        VecCreateMPI(SFEM_COMM_WORLD, n_owned * dim, PETSC_DETERMINE, &coords);
+        VecSetBlockSize(coords, dim);
+        Scalar *coords_values;
+        VecGetArray(coords, &coords_values);
+        for (int i = 0; i < n_owned; i++)
+        {
+            for (int j = 0; j < dim; j++)
+            {
+                coords_values[i * dim + j] = xpts[i * 3 + j];
+            }
+        }
+        VecRestoreArray(coords, &coords_values);
+
+        MatNullSpace near_null_space;
+        MatNullSpaceCreateRigidBody(coords, &near_null_space);
+        MatSetNearNullSpace(A.mat(), near_null_space);
+        MatNullSpaceDestroy(&near_null_space);
+        VecDestroy(&coords);
+    }
+
+    /// @brief Create a dense PetscMat for a given mesh and number of variables per node, with n_cols columns,
+    /// e.g. to hold several right-hand sides or solutions
+    inline PetscMat create_dense_mat(const mesh::Mesh &mesh, int n_vars, int n_cols)
+    {
+        const auto &im = mesh.node_im();
+        Mat B;
+        MatCreateDense(SFEM_COMM_WORLD, im.n_owned() * n_vars, PETSC_DECIDE, im.n_global() * n_vars, n_cols, nullptr, &B);
+        MatSetUp(B);
+        return PetscMat(B, false);
+    }
+
+    /// @brief Copy a column of a dense PetscMat to a PetscVec
+    inline void get_column(const PetscMat &B, int j, PetscVec &x)
+    {
+        MatGetColumnVector(B.mat(), x.vec(), j);
     }
 
     /// @brief Scale a PetscVec by a factor
@@ -38,6 +100,30 @@ namespace sfem::la::petsc
         VecScale(x.vec(), a);
     }
 
+    /// @brief Copy the values of x to y
+    inline void vec_copy(const PetscVec &x, PetscVec &y)
+    {
+        VecCopy(x.vec(), y.vec());
+    }
+
+    /// @brief Compute y += ax
+    inline void vec_axpy(Scalar a, const PetscVec &x, PetscVec &y)
+    {
+        VecAXPY(y.vec(), a, x.vec());
+    }
+
+    /// @brief Compute y = ax + by
+    inline void vec_axpby(Scalar a, const PetscVec &x, Scalar b, PetscVec &y)
+    {
+        VecAXPBY(y.vec(), a, b, x.vec());
+    }
+
+    /// @brief Compute y = Ax
+    inline void mat_mult(const PetscMat &A, const PetscVec &x, PetscVec &y)
+    {
+        MatMult(A.mat(), x.vec(), y.vec());
+    }
+
     /// @brief Compute v3 as v3 = v2 + Av1
     inline void mat_mult_add(const PetscMat &A, const PetscVec &v1, const PetscVec &v2, PetscVec &v3)
     {
@@ -56,6 +142,42 @@ namespace sfem::la::petsc
         MatAXPY(y.mat(), a, x.mat(), SAME_NONZERO_PATTERN);
     }
 
+    /// @brief Create a copy of a PetscMat, with the same non-zero pattern and values
+    inline PetscMat mat_copy(const PetscMat &A)
+    {
+        Mat B;
+        MatDuplicate(A.mat(), MAT_COPY_VALUES, &B);
+        return PetscMat(B, false);
+    }
+
+    /// @brief Copy the Field values of the owned DoF to a PetscVec
+    inline void field_to_vec(const mesh::Field &field, PetscVec &x)
+    {
+        if (x.size_local() != field.n_dof_owned())
+        {
+            error::invalid_size_error(field.n_dof_owned(), x.size_local(), __FILE__, __LINE__);
+        }
+        Scalar *x_values;
+        VecGetArray(x.vec(), &x_values);
+        const auto &values = field.values();
+        std::copy(values.cbegin(), values.cbegin() + field.n_dof_owned(), x_values);
+        VecRestoreArray(x.vec(), &x_values);
+    }
+
+    /// @brief Copy the owned values of a PetscVec to a Field, and update the Field's ghost values
+    inline void vec_to_field(const PetscVec &x, mesh::Field &field)
+    {
+        if (x.size_local() != field.n_dof_owned())
+        {
+            error::invalid_size_error(field.n_dof_owned(), x.size_local(), __FILE__, __LINE__);
+        }
+        const Scalar *x_values;
+        VecGetArrayRead(x.vec(), &x_values);
+        std::copy(x_values, x_values + field.n_dof_owned(), field.values().begin());
+        VecRestoreArrayRead(x.vec(), &x_values);
+        field.update_ghosts();
+    }
+
     /// @brief For a linear system of the form Ax=b,
     /// remove rows and columns of A corresponding to fixed DoF,
     /// and add their contribution to b
@@ -78,6 +200,8 @@ namespace sfem::la::petsc
     }
 
     /// @brief Solve the linear system Ax=b using PETSc's KSP solvers
+    /// @note A new solver is created, and its preconditioner built, on every call. For repeated
+    /// solves with the same operator, keep a PetscKSP instead
     /// @param A Left-hand-side (LHS) matrix
     /// @param b Right-hand-side (RHS) vector
     /// @param x Solution vector
@@ -95,4 +219,20 @@ namespace sfem::la::petsc
         int n_iter = solver.solve(b.vec(), x.vec());
         return n_iter;
     }
+
+    /// @brief Solve the linear systems AX=B for several right-hand sides at once,
+    /// see PetscKSP::mat_solve
+    /// @param A Left-hand-side (LHS) matrix
+    /// @param B Dense matrix holding the right-hand sides, one per column
+    /// @param X Dense matrix where the solutions are stored
+    /// @return Number of iterations performed
+    inline int solve(const PetscMat &A,
+                     const PetscMat &B,
+                     PetscMat &X)
+    {
+        la::petsc::PetscKSP solver;
+        solver.set_from_options();
+        solver.set_operator(A.mat());
+        return solver.mat_solve(B.mat(), X.mat());
+    }
 }
\ No newline at end of file
@@ -91,8 +91,18 @@ namespace sfem::la::petsc
     }
     //=============================================================================
     void PetscVec::assemble()
+    {
+        assemble_begin();
+        assemble_end();
+    }
+    //=============================================================================
+    void PetscVec::assemble_begin()
     {
         VecAssemblyBegin(vec_);
+    }
+    //=============================================================================
+    void PetscVec::assemble_end()
+    {
         VecAssemblyEnd(vec_);
     }
     //=============================================================================
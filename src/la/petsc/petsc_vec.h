@@ -66,6 +66,13 @@ namespace sfem::la::petsc
         /// @brief Assemble the vector
         void assemble();
 
+        /// @brief Start assembling the vector, i.e. start communicating off-process entries
+        /// @note No values may be added until assemble_end is called
+        void assemble_begin();
+
+        /// @brief Complete an assembly started by assemble_begin
+        void assemble_end();
+
         /// @brief Get the (local) values
         /// @note The values for ghost indices are also included
         std::vector<Scalar> get_values() const;
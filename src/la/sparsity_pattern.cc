@@ -7,14 +7,22 @@ namespace sfem::la
 {
     //=============================================================================
     std::pair<std::vector<int>, std::vector<int>> sparsity_pattern(const mesh::Mesh &mesh, int n_vars)
+    {
+        return sparsity_pattern(mesh.cell_node_conn(), mesh.node_im(), mesh.has_ghost_cells(), n_vars);
+    }
+    //=============================================================================
+    std::pair<std::vector<int>, std::vector<int>> sparsity_pattern(const mesh::Connectivity &cell_node_conn,
+                                                                   const IndexMap &node_im,
+                                                                   bool has_ghost_cells,
+                                                                   int n_vars)
     {
         Timer timer("Sparsity pattern calculation");
 
         // Node index map (renumbered)
-        auto im = mesh.node_im().renumber();
+        auto im = node_im.renumber();
 
         // Node-to-node connectivity
-        auto conn = mesh::compute_node_to_node_conn(mesh.cell_node_conn());
+        auto conn = mesh::compute_node_to_node_conn(cell_node_conn);
 
         // Number of non-zeros for locally owned indices
         std::vector<int> diag_nnz(im.n_owned(), 0);
@@ -22,12 +30,21 @@ namespace sfem::la
 
         // Number of non-zeros for ghost indices
         // These have to be sent to the ghost indices' owners
-        std::vector<int> ghost_diag_nnz(im.n_ghost(), 0);
-        std::vector<int> ghost_off_diag_nnz(im.n_ghost(), 0);
+        struct GhostNNZ
+        {
+            int idx;
+            int diag_nnz;
+            int off_diag_nnz;
+        };
+        std::vector<GhostNNZ> ghost_nnz(im.n_ghost());
 
         // Get the ghost indices and their owners
         auto ghost_idxs = im.get_ghost_idxs();
         auto ghost_owners = im.get_ghost_owners();
+        for (int i = 0; i < im.n_ghost(); i++)
+        {
+            ghost_nnz[i] = {ghost_idxs[i], 0, 0};
+        }
 
         // Loop over all indices
         for (int i = 0; i < conn.n1; i++)
@@ -70,29 +87,29 @@ namespace sfem::la
                     // Indices "i" and "j" are owned by the same process
                     if (owner_i == owner_j)
                     {
-                        ghost_diag_nnz[i - im.n_owned()]++;
+                        ghost_nnz[i - im.n_owned()].diag_nnz++;
                     }
                     else
                     {
-                        ghost_off_diag_nnz[i - im.n_owned()]++;
+                        ghost_nnz[i - im.n_owned()].off_diag_nnz++;
                     }
                 }
             }
         }
 
-        // Locally owned indices, that are ghosts for other processes
-        auto a1 = mpi::send_data_to_owners(ghost_owners, ghost_idxs);
-
-        // diag and off-diag non-zeros computed for locally owned indices
-        // by other processes
-        auto a2 = mpi::send_data_to_owners(ghost_owners, ghost_diag_nnz);
-        auto a3 = mpi::send_data_to_owners(ghost_owners, ghost_off_diag_nnz);
-
-        // Add the non-zeros computed non-locally to the local ones
-        for (std::size_t i = 0; i < a1.size(); i++)
+        // Send the non-zeros computed for ghost indices to their owners,
+        // and add them to the locally computed ones.
+        // With a layer of ghost cells, all cells containing an owned index are local,
+        // thus the non-zeros of the owned indices are already complete
+        if (has_ghost_cells == false)
         {
-            diag_nnz[im.global_to_local(a1[i])] += a2[i];
-            off_diag_nnz[im.global_to_local(a1[i])] += a3[i];
+            auto recv_nnz = mpi::send_data_to_owners(ghost_owners, ghost_nnz);
+            for (const auto &nnz : recv_nnz)
+            {
+                int local_idx = im.global_to_local(nnz.idx);
+                diag_nnz[local_idx] += nnz.diag_nnz;
+                off_diag_nnz[local_idx] += nnz.off_diag_nnz;
+            }
         }
 
         // Resize the NNZ vectors for the given number of variables per index
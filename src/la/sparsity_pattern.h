@@ -9,4 +9,13 @@ namespace sfem::la
 {
     std::pair<std::vector<int>, std::vector<int>>
     sparsity_pattern(const mesh::Mesh &mesh, int n_vars);
+
+    /// @brief Get the number of non-zeros of the diagonal and off-diagonal blocks for each owned row,
+    /// for a cell-to-node connectivity other than the mesh's, e.g. restricted to a subset of its nodes
+    /// @param cell_node_conn Cell-to-node connectivity (local node indices)
+    /// @param node_im Node IndexMap, not renumbered
+    /// @param has_ghost_cells Whether the local cells include a layer of ghost cells
+    /// @param n_vars Number of variables per node
+    std::pair<std::vector<int>, std::vector<int>>
+    sparsity_pattern(const mesh::Connectivity &cell_node_conn, const IndexMap &node_im, bool has_ghost_cells, int n_vars);
 }
\ No newline at end of file
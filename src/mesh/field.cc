@@ -44,6 +44,7 @@ namespace sfem::mesh
         }
 
         values_.resize(n_vars * mesh.n_nodes_local());
+        ghost_exchange_ = std::make_shared<common::GhostExchange>(dof_im_, n_vars);
     }
     //=============================================================================
     std::string Field::name() const
@@ -134,6 +135,21 @@ namespace sfem::mesh
         return map_node_dof(cell_nodes);
     }
     //=============================================================================
+    std::vector<int> Field::get_cell_owned_dof(const mesh::Cell &cell) const
+    {
+        auto cell_nodes = mesh_.get_cell_nodes(cell);
+        std::vector<int> dof(cell_nodes.size() * n_vars_);
+        for (std::size_t i = 0; i < cell_nodes.size(); i++)
+        {
+            int node = cell_nodes[i] < dof_im_.n_owned() ? dof_im_.local_to_global(cell_nodes[i]) : -1;
+            for (int j = 0; j < n_vars_; j++)
+            {
+                dof[i * n_vars_ + j] = node >= 0 ? node * n_vars_ + j : -1;
+            }
+        }
+        return dof;
+    }
+    //=============================================================================
     std::vector<Scalar> Field::get_cell_values(const mesh::Cell &cell) const
     {
         auto cell_nodes = mesh_.get_cell_nodes(cell);
@@ -180,6 +196,47 @@ namespace sfem::mesh
         return fdof_values;
     }
     //=============================================================================
+    std::pair<std::vector<int>, std::vector<Scalar>> Field::get_local_fixed_dof() const
+    {
+        // Flag and value for each local DoF
+        std::vector<Scalar> flags(n_dof_local(), 0.0);
+        std::vector<Scalar> values(n_dof_local(), 0.0);
+        for (auto kv : fixed_dof_)
+        {
+            int node = dof_im_.global_to_local(kv.first / n_vars_);
+            int dof = node * n_vars_ + kv.first % n_vars_;
+            flags[dof] = 1.0;
+            values[dof] = kv.second;
+        }
+
+        // Owners collect the fixed DoF from all processes,
+        // and then broadcast them back to the processes where they are ghosts
+        ghost_exchange_->reverse(flags);
+        ghost_exchange_->reverse(values);
+        for (int i = 0; i < n_dof_owned(); i++)
+        {
+            if (flags[i] > 0)
+            {
+                values[i] /= flags[i];
+                flags[i] = 1.0;
+            }
+        }
+        ghost_exchange_->forward(flags);
+        ghost_exchange_->forward(values);
+
+        std::vector<int> local_fixed_dof;
+        std::vector<Scalar> local_fixed_dof_values;
+        for (int i = 0; i < n_dof_local(); i++)
+        {
+            if (flags[i] > 0)
+            {
+                local_fixed_dof.push_back(i);
+                local_fixed_dof_values.push_back(values[i]);
+            }
+        }
+        return std::make_pair(local_fixed_dof, local_fixed_dof_values);
+    }
+    //=============================================================================
     void Field::clear_fixed_dof()
     {
         fixed_dof_.clear();
@@ -215,6 +272,26 @@ namespace sfem::mesh
         return values_;
     }
     //=============================================================================
+    std::vector<Scalar> &Field::values()
+    {
+        return values_;
+    }
+    //=============================================================================
+    std::shared_ptr<common::GhostExchange> Field::ghost_exchange() const
+    {
+        return ghost_exchange_;
+    }
+    //=============================================================================
+    void Field::update_ghosts()
+    {
+        ghost_exchange_->forward(values_);
+    }
+    //=============================================================================
+    void Field::accumulate_ghosts()
+    {
+        ghost_exchange_->reverse(values_);
+    }
+    //=============================================================================
     std::vector<Scalar> gather_field_values(const Field &field)
     {
         int n_procs = Logger::instance().n_procs();
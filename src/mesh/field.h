@@ -1,6 +1,8 @@
 #pragma once
 
 #include "mesh.h"
+#include "../common/ghost_exchange.h"
+#include <memory>
 
 namespace sfem::mesh
 {
@@ -75,6 +77,10 @@ namespace sfem::mesh
         /// @note The DoF are returned in global indexing
         std::vector<int> get_cell_dof(const mesh::Cell &cell) const;
 
+        /// @brief Get the DoF belonging to a cell, that are owned by this process
+        /// @note The DoF are returned in global indexing. DoF not owned by this process are set to -1
+        std::vector<int> get_cell_owned_dof(const mesh::Cell &cell) const;
+
         /// @brief Get the values belonging to a cell
         std::vector<Scalar> get_cell_values(const mesh::Cell &cell) const;
 
@@ -87,6 +93,12 @@ namespace sfem::mesh
         /// brief Get the values of the fixed DoF
         std::vector<Scalar> get_fixed_dof_values() const;
 
+        /// @brief Get all fixed DoF local to this process (owned + ghost) and their values
+        /// @note The DoF are returned in local indexing
+        /// @note Collective. A process may not be aware of all its local fixed DoF, e.g. when the
+        /// fixed region's cells belong to another process, thus these are first synchronised
+        std::pair<std::vector<int>, std::vector<Scalar>> get_local_fixed_dof() const;
+
         /// @brief Clear all existing fixed DoF
         void clear_fixed_dof();
 
@@ -100,6 +112,20 @@ namespace sfem::mesh
         /// @brief Get local DoF values
         const std::vector<Scalar> &values() const;
 
+        /// @brief Get local DoF values (mutable)
+        /// @note Call update_ghosts after modifying the owned values
+        std::vector<Scalar> &values();
+
+        /// @brief Get the ghost exchange for the local DoF values
+        std::shared_ptr<common::GhostExchange> ghost_exchange() const;
+
+        /// @brief Update the ghost DoF values with the values of their owners
+        void update_ghosts();
+
+        /// @brief Add the ghost DoF values to the values of their owners
+        /// @note The ghost DoF values are left unchanged
+        void accumulate_ghosts();
+
     private:
         /// @brief Field name
         std::string name_;
@@ -121,6 +147,9 @@ namespace sfem::mesh
 
         /// @brief Values corresponding to the local DoF
         std::vector<Scalar> values_;
+
+        /// @brief Owner-ghost communication for the DoF values
+        std::shared_ptr<common::GhostExchange> ghost_exchange_;
     };
 
     /// @brief Assemble all Field values to the root process
@@ -1,6 +1,7 @@
 #include "mesh.h"
 #include "../common/logger.h"
 #include "../common/error.h"
+#include <mpi.h>
 
 namespace sfem::mesh
 {
@@ -37,6 +38,27 @@ namespace sfem::mesh
                 dim_ = region.dim();
             }
         }
+
+        // Check whether any process has ghost cells
+        int has_ghost_cells_local = cell_im.n_ghost() > 0;
+        int has_ghost_cells_global;
+        MPI_Allreduce(&has_ghost_cells_local, &has_ghost_cells_global, 1, MPI_INT, MPI_MAX, SFEM_COMM_WORLD);
+        has_ghost_cells_ = has_ghost_cells_global;
+
+        // Flag the interface cells, i.e. cells with at least one ghost node
+        int n_nodes_owned = node_im_.n_owned();
+        is_interface_cell_.assign(cells_.size(), false);
+        for (std::size_t i = 0; i < cells_.size(); i++)
+        {
+            for (int j = 0; j < cells_[i].n_nodes(); j++)
+            {
+                if (conn_.idx[conn_.ptr[i] + j] >= n_nodes_owned)
+                {
+                    is_interface_cell_[i] = true;
+                    break;
+                }
+            }
+        }
     }
     //=============================================================================
     void Mesh::info() const
@@ -164,6 +186,22 @@ namespace sfem::mesh
         return region_nodes;
     }
     //=============================================================================
+    bool Mesh::has_ghost_cells() const
+    {
+        return has_ghost_cells_;
+    }
+    //=============================================================================
+    bool Mesh::is_cell_owned(const Cell &cell) const
+    {
+        int local_idx = cell_im_.global_to_local(cell.idx());
+        return local_idx >= 0 && local_idx < cell_im_.n_owned();
+    }
+    //=============================================================================
+    bool Mesh::is_interface_cell(const Cell &cell) const
+    {
+        return is_interface_cell_[cell_im_.global_to_local(cell.idx())];
+    }
+    //=============================================================================
     std::vector<int> Mesh::get_cell_nodes(const Cell &cell) const
     {
         std::vector<int> cell_nodes(cell.n_nodes());
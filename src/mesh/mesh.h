@@ -84,6 +84,16 @@ namespace sfem::mesh
         /// @note Nodes are returned in local indexing
         std::vector<int> get_region_nodes(const std::string &region_name) const;
 
+        /// @brief Whether the mesh includes a layer of ghost cells (on any process)
+        bool has_ghost_cells() const;
+
+        /// @brief Whether a cell is owned by this process
+        bool is_cell_owned(const Cell &cell) const;
+
+        /// @brief Whether a cell is an interface cell, i.e. has at least one ghost node
+        /// @note Contributions from the remaining (interior) cells never have to be communicated
+        bool is_interface_cell(const Cell &cell) const;
+
         /// @brief Get the nodes of a cell
         /// @note Nodes are returned in local indexing
         std::vector<int> get_cell_nodes(const Cell &cell) const;
@@ -113,5 +123,11 @@ namespace sfem::mesh
 
         /// @brief Physical dimension
         int dim_;
+
+        /// @brief Whether any process has ghost cells
+        bool has_ghost_cells_;
+
+        /// @brief Whether each local cell is an interface cell
+        std::vector<bool> is_interface_cell_;
     };
 }
\ No newline at end of file
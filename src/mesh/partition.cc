@@ -2,6 +2,7 @@
 #include "../common/logger.h"
 #include "../common/error.h"
 #include <mpi.h>
+#include <set>
 
 #ifdef SFEM_HAS_METIS
 #include <metis.h>
@@ -10,8 +11,8 @@
 namespace sfem::mesh
 {
     //=============================================================================
-    Partitioner::Partitioner(int n_parts, const Connectivity &conn)
-        : n_parts_(n_parts), conn_(conn)
+    Partitioner::Partitioner(int n_parts, const Connectivity &conn, bool ghost_cells)
+        : n_parts_(n_parts), conn_(conn), ghost_cells_(ghost_cells)
     {
     }
     //=============================================================================
@@ -63,6 +64,12 @@ namespace sfem::mesh
                 data_per_proc[node_owners[i]].node_idxs.push_back(i);
             }
 
+            // Compute the ghost cells for each process
+            if (ghost_cells_)
+            {
+                compute_ghost_cells(cell_owners, node_owners, data_per_proc);
+            }
+
             // Compute the ghost nodes for each process
             compute_ghost_nodes(node_owners, data_per_proc);
         }
@@ -71,6 +78,35 @@ namespace sfem::mesh
         return distribute_partition_data(data_per_proc);
     }
     //=============================================================================
+    void Partitioner::compute_ghost_cells(const std::vector<int> &cell_owners, const std::vector<int> &node_owners, std::vector<PartitionData> &data_per_proc) const
+    {
+        // A cell is a ghost for every other process that owns one of its nodes
+        std::vector<std::set<int>> ghost_cells_per_proc(n_parts_);
+        for (int i = 0; i < conn_.n1; i++)
+        {
+            for (int k = 0; k < conn_.cnt[i]; k++)
+            {
+                int owner = node_owners[conn_.idx[conn_.ptr[i] + k]];
+                if (owner != cell_owners[i])
+                {
+                    ghost_cells_per_proc[owner].insert(i);
+                }
+            }
+        }
+
+        // Assign ghost cells to each process
+        for (int i = 0; i < n_parts_; i++)
+        {
+            data_per_proc[i].ghost_cell_idxs.reserve(ghost_cells_per_proc[i].size());
+            data_per_proc[i].ghost_cell_owners.reserve(ghost_cells_per_proc[i].size());
+            for (auto cell_idx : ghost_cells_per_proc[i])
+            {
+                data_per_proc[i].ghost_cell_idxs.push_back(cell_idx);
+                data_per_proc[i].ghost_cell_owners.push_back(cell_owners[cell_idx]);
+            }
+        }
+    }
+    //=============================================================================
     void Partitioner::compute_ghost_nodes(const std::vector<int> &node_owners, std::vector<PartitionData> &data_per_proc) const
     {
         // Count ghost nodes per process
@@ -78,9 +114,11 @@ namespace sfem::mesh
         for (int i = 0; i < n_parts_; i++)
         {
             std::unordered_map<int, short> is_node_included;
-            for (std::size_t j = 0; j < data_per_proc[i].cell_idxs.size(); j++)
+            auto cell_idxs = data_per_proc[i].cell_idxs;
+            cell_idxs.insert(cell_idxs.end(), data_per_proc[i].ghost_cell_idxs.begin(), data_per_proc[i].ghost_cell_idxs.end());
+            for (std::size_t j = 0; j < cell_idxs.size(); j++)
             {
-                int cell_idx = data_per_proc[i].cell_idxs[j];
+                int cell_idx = cell_idxs[j];
                 for (int k = 0; k < conn_.cnt[cell_idx]; k++)
                 {
                     int node_idx = conn_.idx[conn_.ptr[cell_idx] + k];
@@ -103,9 +141,11 @@ namespace sfem::mesh
         for (int i = 0; i < n_parts_; i++)
         {
             std::unordered_map<int, short> is_node_included;
-            for (std::size_t j = 0; j < data_per_proc[i].cell_idxs.size(); j++)
+            auto cell_idxs = data_per_proc[i].cell_idxs;
+            cell_idxs.insert(cell_idxs.end(), data_per_proc[i].ghost_cell_idxs.begin(), data_per_proc[i].ghost_cell_idxs.end());
+            for (std::size_t j = 0; j < cell_idxs.size(); j++)
             {
-                int cell_idx = data_per_proc[i].cell_idxs[j];
+                int cell_idx = cell_idxs[j];
                 for (int k = 0; k < conn_.cnt[cell_idx]; k++)
                 {
                     int node_idx = conn_.idx[conn_.ptr[cell_idx] + k];
@@ -130,6 +170,11 @@ namespace sfem::mesh
         std::vector<int> cell_idxs_per_proc;
         std::vector<int> cell_counts(n_parts_, 0);
         std::vector<int> cell_displs(n_parts_, 0);
+        // Ghost cells
+        std::vector<int> ghost_cell_idxs_per_proc;
+        std::vector<int> ghost_cell_owners_per_proc;
+        std::vector<int> ghost_cell_counts(n_parts_, 0);
+        std::vector<int> ghost_cell_displs(n_parts_, 0);
         // Nodes
         std::vector<int> node_idxs_per_proc;
         std::vector<int> node_counts(n_parts_, 0);
@@ -144,15 +189,19 @@ namespace sfem::mesh
             for (int i = 0; i < n_parts_; i++)
             {
                 cell_counts[i] = data_per_proc[i].cell_idxs.size();
+                ghost_cell_counts[i] = data_per_proc[i].ghost_cell_idxs.size();
                 node_counts[i] = data_per_proc[i].node_idxs.size();
                 ghost_counts[i] = data_per_proc[i].ghost_idxs.size();
                 if (i > 0)
                 {
                     cell_displs[i] = cell_displs[i - 1] + data_per_proc[i - 1].cell_idxs.size();
+                    ghost_cell_displs[i] = ghost_cell_displs[i - 1] + data_per_proc[i - 1].ghost_cell_idxs.size();
                     node_displs[i] = node_displs[i - 1] + data_per_proc[i - 1].node_idxs.size();
                     ghost_displs[i] = ghost_displs[i - 1] + data_per_proc[i - 1].ghost_idxs.size();
                 }
                 cell_idxs_per_proc.reserve(cell_idxs_per_proc.size() + data_per_proc[i].cell_idxs.size());
+                ghost_cell_idxs_per_proc.reserve(ghost_cell_idxs_per_proc.size() + data_per_proc[i].ghost_cell_idxs.size());
+                ghost_cell_owners_per_proc.reserve(ghost_cell_owners_per_proc.size() + data_per_proc[i].ghost_cell_owners.size());
                 node_idxs_per_proc.reserve(node_idxs_per_proc.size() + data_per_proc[i].node_idxs.size());
                 ghost_idxs_per_proc.reserve(ghost_idxs_per_proc.size() + data_per_proc[i].ghost_idxs.size());
                 ghost_owners_per_proc.reserve(ghost_idxs_per_proc.size() + data_per_proc[i].ghost_owners.size());
@@ -163,6 +212,11 @@ namespace sfem::mesh
                 {
                     cell_idxs_per_proc.push_back(data_per_proc[i].cell_idxs[j]);
                 }
+                for (std::size_t j = 0; j < data_per_proc[i].ghost_cell_idxs.size(); j++)
+                {
+                    ghost_cell_idxs_per_proc.push_back(data_per_proc[i].ghost_cell_idxs[j]);
+                    ghost_cell_owners_per_proc.push_back(data_per_proc[i].ghost_cell_owners[j]);
+                }
                 for (std::size_t j = 0; j < data_per_proc[i].node_idxs.size(); j++)
                 {
                     node_idxs_per_proc.push_back(data_per_proc[i].node_idxs[j]);
@@ -180,6 +234,13 @@ namespace sfem::mesh
         data.cell_idxs.resize(n_cells);
         MPI_Scatterv(cell_idxs_per_proc.data(), cell_counts.data(), cell_displs.data(), MPI_INT, data.cell_idxs.data(), data.cell_idxs.size(), MPI_INT, SFEM_ROOT, SFEM_COMM_WORLD);
 
+        int n_ghost_cells;
+        MPI_Scatter(ghost_cell_counts.data(), 1, MPI_INT, &n_ghost_cells, 1, MPI_INT, SFEM_ROOT, SFEM_COMM_WORLD);
+        data.ghost_cell_idxs.resize(n_ghost_cells);
+        data.ghost_cell_owners.resize(n_ghost_cells);
+        MPI_Scatterv(ghost_cell_idxs_per_proc.data(), ghost_cell_counts.data(), ghost_cell_displs.data(), MPI_INT, data.ghost_cell_idxs.data(), data.ghost_cell_idxs.size(), MPI_INT, SFEM_ROOT, SFEM_COMM_WORLD);
+        MPI_Scatterv(ghost_cell_owners_per_proc.data(), ghost_cell_counts.data(), ghost_cell_displs.data(), MPI_INT, data.ghost_cell_owners.data(), data.ghost_cell_owners.size(), MPI_INT, SFEM_ROOT, SFEM_COMM_WORLD);
+
         int n_nodes;
         MPI_Scatter(node_counts.data(), 1, MPI_INT, &n_nodes, 1, MPI_INT, SFEM_ROOT, SFEM_COMM_WORLD);
         data.node_idxs.resize(n_nodes);
@@ -192,17 +253,17 @@ namespace sfem::mesh
         MPI_Scatterv(ghost_idxs_per_proc.data(), ghost_counts.data(), ghost_displs.data(), MPI_INT, data.ghost_idxs.data(), data.ghost_idxs.size(), MPI_INT, SFEM_ROOT, SFEM_COMM_WORLD);
         MPI_Scatterv(ghost_owners_per_proc.data(), ghost_counts.data(), ghost_displs.data(), MPI_INT, data.ghost_owners.data(), data.ghost_owners.size(), MPI_INT, SFEM_ROOT, SFEM_COMM_WORLD);
 
-        return std::make_pair(common::IndexMap(data.cell_idxs, {}, {}), common::IndexMap(data.node_idxs, data.ghost_idxs, data.ghost_owners));
+        return std::make_pair(common::IndexMap(data.cell_idxs, data.ghost_cell_idxs, data.ghost_cell_owners), common::IndexMap(data.node_idxs, data.ghost_idxs, data.ghost_owners));
     }
     //=============================================================================
-    Partitioner *create_partitioner(const std::string &type, int n_parts, const Connectivity &conn)
+    Partitioner *create_partitioner(const std::string &type, int n_parts, const Connectivity &conn, bool ghost_cells)
     {
         Partitioner *partitioner = nullptr;
 
         if (type == "METIS")
         {
 #ifdef SFEM_HAS_METIS
-            partitioner = new METISPartitioner(n_parts, conn);
+            partitioner = new METISPartitioner(n_parts, conn, ghost_cells);
 #else
             Logger::GetInstance().Error("SFEM was not compiled with METIS. Add SFEM_USE_METIS=ON and re-compile the library.\n", __FILE__, __LINE__);
 #endif // SFEM_USE_METIS
@@ -217,7 +278,7 @@ namespace sfem::mesh
     }
     //=============================================================================
 #ifdef SFEM_HAS_METIS
-    METISPartitioner::METISPartitioner(int n_parts, const Connectivity &conn) : Partitioner(n_parts, conn)
+    METISPartitioner::METISPartitioner(int n_parts, const Connectivity &conn, bool ghost_cells) : Partitioner(n_parts, conn, ghost_cells)
     {
     }
     //=============================================================================
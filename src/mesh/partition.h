@@ -12,7 +12,9 @@ namespace sfem::mesh
         /// @brief Create a Partitioner
         /// @param n_parts Desired number of partitions
         /// @param cell_node_conn Cell-to-node connectivity of the mesh
-        Partitioner(int n_parts, const Connectivity &cell_node_conn);
+        /// @param ghost_cells Whether to add a layer of ghost cells to each partition, i.e. all
+        /// cells owned by other processes that contain a node owned by this process
+        Partitioner(int n_parts, const Connectivity &cell_node_conn, bool ghost_cells = false);
 
         /// @brief Destructor (virtual)
         virtual ~Partitioner() = 0;
@@ -25,6 +27,8 @@ namespace sfem::mesh
         struct PartitionData
         {
             std::vector<int> cell_idxs;
+            std::vector<int> ghost_cell_idxs;
+            std::vector<int> ghost_cell_owners;
             std::vector<int> node_idxs;
             std::vector<int> ghost_idxs;
             std::vector<int> ghost_owners;
@@ -36,6 +40,12 @@ namespace sfem::mesh
         /// @return The list of the owning process for each cell/node
         virtual std::pair<std::vector<int>, std::vector<int>> compute_owners() const = 0;
 
+        /// @brief Compute the ghost cells for each process.
+        /// @param cell_owners List of owning process for each cell.
+        /// @param node_owners List of owning process for each node.
+        /// @param data List of PartitionData for each process.
+        void compute_ghost_cells(const std::vector<int> &cell_owners, const std::vector<int> &node_owners, std::vector<PartitionData> &data) const;
+
         /// @brief Compute the ghost nodes for each process.
         /// @param node_owners List of owning process for each node.
         /// @param data List of PartitionData for each process.
@@ -48,17 +58,20 @@ namespace sfem::mesh
 
         /// @brief Cell-to-node connectivity of the mesh to be partitioned
         const Connectivity &conn_;
+
+        /// @brief Whether to add a layer of ghost cells
+        bool ghost_cells_;
     };
 
     /// @brief Constructs a Partitioner given the type, e.g METIS
-    Partitioner *create_partitioner(const std::string &type, int n_parts, const Connectivity &conn);
+    Partitioner *create_partitioner(const std::string &type, int n_parts, const Connectivity &conn, bool ghost_cells = false);
 
 #ifdef SFEM_HAS_METIS
     /// @brief Partition the Mesh using METIS
     class METISPartitioner : public Partitioner
     {
     public:
-        METISPartitioner(int n_parts, const Connectivity &conn);
+        METISPartitioner(int n_parts, const Connectivity &conn, bool ghost_cells = false);
 
     private:
         std::pair<std::vector<int>, std::vector<int>> compute_owners() const override;
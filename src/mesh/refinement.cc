@@ -0,0 +1,584 @@
+#include "refinement.h"
+#include "../common/ghost_exchange.h"
+#include "../common/mpi_utils.h"
+#include "../common/logger.h"
+#include "../common/timer.h"
+#include <array>
+#include <bitset>
+#include <map>
+#include <unordered_map>
+#include <mpi.h>
+
+namespace sfem::mesh
+{
+    namespace
+    {
+        /// @brief Refinement entity (edge, quad face or cell interior), identified by the sorted
+        /// global indices of its parent vertices, padded with -1
+        using EntityKey = std::array<int, 8>;
+
+        /// @brief Query sent to the process deciding the owner of a shared entity
+        struct OwnerQuery
+        {
+            EntityKey key;
+            int rank;
+        };
+
+        /// @brief Get the children of a cell type
+        /// @note Each child node is described by the set (bit mask) of parent vertices of which it is the centroid
+        std::vector<std::vector<int>> child_templates(CellType type)
+        {
+            std::vector<std::vector<int>> children;
+            switch (type)
+            {
+            case CellType::point:
+                children = {{1}};
+                break;
+
+            case CellType::line:
+            case CellType::quad:
+            case CellType::hex:
+            {
+                // Tensor product cells: the children are the cells of a 3^d lattice, whose points
+                // are the centroids of the parent vertices they coincide with along each direction
+                int d = cell_dim(type);
+                std::vector<std::array<int, 3>> corners = {{0, 0, 0}, {2, 0, 0}, {2, 2, 0}, {0, 2, 0},
+                                                           {0, 0, 2}, {2, 0, 2}, {2, 2, 2}, {0, 2, 2}};
+                int n_vertices = 1 << d;
+                corners.resize(n_vertices);
+                auto mask = [&](const std::array<int, 3> &p)
+                {
+                    int m = 0;
+                    for (int w = 0; w < n_vertices; w++)
+                    {
+                        bool match = true;
+                        for (int k = 0; k < d; k++)
+                        {
+                            match = match && (p[k] == 1 || p[k] == corners[w][k]);
+                        }
+                        m |= match ? 1 << w : 0;
+                    }
+                    return m;
+                };
+                for (int a = 0; a < n_vertices; a++)
+                {
+                    // Lattice position of the child, given by the parent vertex it contains
+                    std::vector<int> child;
+                    for (int v = 0; v < n_vertices; v++)
+                    {
+                        std::array<int, 3> p = {0, 0, 0};
+                        for (int k = 0; k < d; k++)
+                        {
+                            p[k] = corners[a][k] / 2 + corners[v][k] / 2;
+                        }
+                        child.push_back(mask(p));
+                    }
+                    children.push_back(child);
+                }
+                break;
+            }
+
+            case CellType::triangle:
+                children = {{1, 3, 5}, {3, 2, 6}, {5, 6, 4}, {3, 6, 5}};
+                break;
+
+            case CellType::tet:
+            {
+                // Corner tets, and the inner octahedron split along its (02)-(13) diagonal
+                int x01 = 3, x02 = 5, x03 = 9, x12 = 6, x13 = 10, x23 = 12;
+                children = {{1, x01, x02, x03}, {x01, 2, x12, x13}, {x02, x12, 4, x23}, {x03, x13, x23, 8},
+                            {x01, x02, x03, x13}, {x01, x02, x12, x13}, {x02, x03, x13, x23}, {x02, x12, x13, x23}};
+
+                // Keep the orientation of the parent
+                Scalar ref[4][3] = {{0, 0, 0}, {1, 0, 0}, {0, 1, 0}, {0, 0, 1}};
+                for (auto &child : children)
+                {
+                    Scalar p[4][3] = {{0}};
+                    for (int i = 0; i < 4; i++)
+                    {
+                        int n = static_cast<int>(std::bitset<8>(child[i]).count());
+                        for (int v = 0; v < 4; v++)
+                        {
+                            for (int k = 0; k < 3; k++)
+                            {
+                                p[i][k] += (child[i] >> v & 1) ? ref[v][k] / n : 0;
+                            }
+                        }
+                    }
+                    Scalar e[3][3];
+                    for (int i = 0; i < 3; i++)
+                    {
+                        for (int k = 0; k < 3; k++)
+                        {
+                            e[i][k] = p[i + 1][k] - p[0][k];
+                        }
+                    }
+                    Scalar det = e[0][0] * (e[1][1] * e[2][2] - e[1][2] * e[2][1]) -
+                                 e[0][1] * (e[1][0] * e[2][2] - e[1][2] * e[2][0]) +
+                                 e[0][2] * (e[1][0] * e[2][1] - e[1][1] * e[2][0]);
+                    if (det < 0)
+                    {
+                        std::swap(child[1], child[2]);
+                    }
+                }
+                break;
+            }
+
+            default:
+                Logger::instance().error("Unsupported cell type for uniform refinement", __FILE__, __LINE__);
+            }
+
+            return children;
+        }
+    }
+    //=============================================================================
+    Mesh refine_uniform(const Mesh &mesh)
+    {
+        // Time the refinement
+        common::Timer timer("Mesh refinement");
+
+        int proc_rank = Logger::instance().proc_rank();
+        const auto &cells = mesh.cells();
+        const auto &conn = mesh.cell_node_conn();
+        const auto &xpts = mesh.xpts();
+        const auto &node_im = mesh.node_im();
+        const auto &cell_im = mesh.cell_im();
+        int n_nodes_owned = node_im.n_owned();
+        int n_nodes_local = node_im.n_local();
+        int n_cells_owned = cell_im.n_owned();
+        int n_cells_local = cell_im.n_local();
+        auto node_ghost_owners = node_im.get_ghost_owners();
+        auto cell_ghost_owners = cell_im.get_ghost_owners();
+
+        // Children of each cell type
+        std::map<CellType, std::vector<std::vector<int>>> templates;
+        for (const auto &cell : cells)
+        {
+            if (cell.order() != 1)
+            {
+                Logger::instance().error("Uniform refinement only supports linear cells", __FILE__, __LINE__);
+            }
+            if (templates.count(cell.type()) == 0)
+            {
+                templates[cell.type()] = child_templates(cell.type());
+            }
+        }
+
+        // Nodes shared with other processes, i.e. ghosts here or elsewhere
+        std::vector<bool> is_shared(n_nodes_local, false);
+        if (Logger::instance().n_procs() > 1)
+        {
+            std::vector<Scalar> flags(n_nodes_local, 0.0);
+            std::fill(flags.begin() + n_nodes_owned, flags.end(), 1.0);
+            common::GhostExchange exchange(node_im);
+            exchange.reverse(flags);
+            for (int i = 0; i < n_nodes_local; i++)
+            {
+                is_shared[i] = flags[i] > 0;
+            }
+        }
+
+        // Create the children nodes, i.e. the parent vertices (local index i) and the new entities (-e - 1)
+        std::map<EntityKey, int> entity_idxs;
+        std::vector<EntityKey> entity_keys;
+        std::vector<Scalar> entity_xpts;
+        std::vector<int> entity_rendezvous;
+        std::vector<bool> entity_is_shared;
+        std::vector<int> child_nodes;
+        for (int c = 0; c < n_cells_local; c++)
+        {
+            const int *nodes = &conn.idx[conn.ptr[c]];
+            for (const auto &child : templates.at(cells[c].type()))
+            {
+                for (int mask : child)
+                {
+                    std::vector<int> vertices;
+                    for (int v = 0; v < cells[c].n_nodes(); v++)
+                    {
+                        if (mask >> v & 1)
+                        {
+                            vertices.push_back(nodes[v]);
+                        }
+                    }
+                    if (vertices.size() == 1)
+                    {
+                        child_nodes.push_back(vertices[0]);
+                        continue;
+                    }
+
+                    std::sort(vertices.begin(), vertices.end(), [&](int a, int b)
+                              { return node_im.local_to_global(a) < node_im.local_to_global(b); });
+                    EntityKey key;
+                    key.fill(-1);
+                    for (std::size_t i = 0; i < vertices.size(); i++)
+                    {
+                        key[i] = node_im.local_to_global(vertices[i]);
+                    }
+
+                    auto it = entity_idxs.find(key);
+                    if (it == entity_idxs.end())
+                    {
+                        it = entity_idxs.emplace(key, static_cast<int>(entity_keys.size())).first;
+                        entity_keys.push_back(key);
+
+                        // Centroid of the parent vertices
+                        bool shared = Logger::instance().n_procs() > 1;
+                        for (int k = 0; k < 3; k++)
+                        {
+                            Scalar x = 0;
+                            for (int v : vertices)
+                            {
+                                x += xpts[v * 3 + k] / vertices.size();
+                            }
+                            entity_xpts.push_back(x);
+                        }
+                        for (int v : vertices)
+                        {
+                            shared = shared && is_shared[v];
+                        }
+                        entity_is_shared.push_back(shared);
+
+                        // The owner of the first vertex decides the owner of a shared entity
+                        int v = vertices[0];
+                        entity_rendezvous.push_back(v < n_nodes_owned ? proc_rank : node_ghost_owners[v - n_nodes_owned]);
+                    }
+                    child_nodes.push_back(-it->second - 1);
+                }
+            }
+        }
+        int n_entities = static_cast<int>(entity_keys.size());
+
+        // Owners of the shared entities: the deciding process if it holds the entity, since then it holds
+        // all cells containing it when the mesh has ghost cells, or the lowest holding process otherwise
+        std::vector<int> entity_owners(n_entities, proc_rank);
+        {
+            std::vector<int> shared_entities;
+            std::vector<int> dest_ranks;
+            std::vector<OwnerQuery> queries;
+            for (int e = 0; e < n_entities; e++)
+            {
+                if (entity_is_shared[e])
+                {
+                    shared_entities.push_back(e);
+                    dest_ranks.push_back(entity_rendezvous[e]);
+                    queries.push_back({entity_keys[e], proc_rank});
+                }
+            }
+            auto owners = mpi::query_processes<int>(dest_ranks, queries, [&](const std::vector<OwnerQuery> &received)
+                                                    {
+                std::map<EntityKey, int> owner;
+                for (const auto &query : received)
+                {
+                    auto it = owner.find(query.key);
+                    if (it == owner.end())
+                    {
+                        owner[query.key] = query.rank;
+                    }
+                    else
+                    {
+                        bool is_local = it->second == proc_rank || query.rank == proc_rank;
+                        it->second = is_local ? proc_rank : std::min(it->second, query.rank);
+                    }
+                }
+                std::vector<int> answers;
+                for (const auto &query : received)
+                {
+                    answers.push_back(owner.at(query.key));
+                }
+                return answers; });
+            for (std::size_t i = 0; i < shared_entities.size(); i++)
+            {
+                entity_owners[shared_entities[i]] = owners[i];
+            }
+        }
+
+        // Global indices of the new nodes, numbered after the parent nodes
+        std::vector<int> entity_global(n_entities, -1);
+        {
+            int n_vertices_global = 0;
+            for (int i = 0; i < n_nodes_local; i++)
+            {
+                n_vertices_global = std::max(n_vertices_global, node_im.local_to_global(i) + 1);
+            }
+            MPI_Allreduce(MPI_IN_PLACE, &n_vertices_global, 1, MPI_INT, MPI_MAX, SFEM_COMM_WORLD);
+
+            int n_owned_entities = static_cast<int>(std::count(entity_owners.cbegin(), entity_owners.cend(), proc_rank));
+            int offset = 0;
+            MPI_Exscan(&n_owned_entities, &offset, 1, MPI_INT, MPI_SUM, SFEM_COMM_WORLD);
+            if (proc_rank == 0)
+            {
+                offset = 0;
+            }
+            for (int e = 0; e < n_entities; e++)
+            {
+                if (entity_owners[e] == proc_rank)
+                {
+                    entity_global[e] = n_vertices_global + offset++;
+                }
+            }
+
+            // The other entities are numbered by their owners
+            std::vector<int> ghost_entities;
+            std::vector<int> dest_ranks;
+            std::vector<EntityKey> queries;
+            for (int e = 0; e < n_entities; e++)
+            {
+                if (entity_owners[e] != proc_rank)
+                {
+                    ghost_entities.push_back(e);
+                    dest_ranks.push_back(entity_owners[e]);
+                    queries.push_back(entity_keys[e]);
+                }
+            }
+            auto idxs = mpi::query_processes<int>(dest_ranks, queries, [&](const std::vector<EntityKey> &received)
+                                                  {
+                std::vector<int> answers;
+                for (const auto &key : received)
+                {
+                    answers.push_back(entity_global[entity_idxs.at(key)]);
+                }
+                return answers; });
+            for (std::size_t i = 0; i < ghost_entities.size(); i++)
+            {
+                entity_global[ghost_entities[i]] = idxs[i];
+            }
+        }
+
+        // Global indices of the children, numbered contiguously by the owner of their parent
+        std::vector<int> child_base(n_cells_local);
+        {
+            int n_children_owned = 0;
+            for (int c = 0; c < n_cells_owned; c++)
+            {
+                n_children_owned += static_cast<int>(templates.at(cells[c].type()).size());
+            }
+            int offset = 0;
+            MPI_Exscan(&n_children_owned, &offset, 1, MPI_INT, MPI_SUM, SFEM_COMM_WORLD);
+            if (proc_rank == 0)
+            {
+                offset = 0;
+            }
+            std::unordered_map<int, int> owned_child_base;
+            for (int c = 0; c < n_cells_owned; c++)
+            {
+                child_base[c] = offset;
+                owned_child_base[cells[c].idx()] = offset;
+                offset += static_cast<int>(templates.at(cells[c].type()).size());
+            }
+
+            std::vector<int> queries;
+            for (int c = n_cells_owned; c < n_cells_local; c++)
+            {
+                queries.push_back(cells[c].idx());
+            }
+            auto bases = mpi::query_processes<int>(cell_ghost_owners, queries, [&](const std::vector<int> &received)
+                                                   {
+                std::vector<int> answers;
+                for (int idx : received)
+                {
+                    answers.push_back(owned_child_base.at(idx));
+                }
+                return answers; });
+            std::copy(bases.cbegin(), bases.cend(), child_base.begin() + n_cells_owned);
+        }
+
+        // The children of the ghost cells are only kept if they contain an owned node,
+        // consistently with the ghost cells of the Partitioner
+        auto is_node_owned = [&](int node)
+        {
+            return node >= 0 ? node < n_nodes_owned : entity_owners[-node - 1] == proc_rank;
+        };
+        std::vector<bool> is_child_kept;
+        std::vector<bool> is_node_used(n_nodes_local + n_entities, false);
+        auto node_pos = [&](int node)
+        {
+            return node >= 0 ? node : n_nodes_local - node - 1;
+        };
+        {
+            std::size_t pos = 0;
+            for (int c = 0; c < n_cells_local; c++)
+            {
+                for (const auto &child : templates.at(cells[c].type()))
+                {
+                    bool keep = c < n_cells_owned;
+                    for (std::size_t i = 0; i < child.size(); i++)
+                    {
+                        keep = keep || is_node_owned(child_nodes[pos + i]);
+                    }
+                    if (keep)
+                    {
+                        for (std::size_t i = 0; i < child.size(); i++)
+                        {
+                            is_node_used[node_pos(child_nodes[pos + i])] = true;
+                        }
+                    }
+                    is_child_kept.push_back(keep);
+                    pos += child.size();
+                }
+            }
+        }
+
+        // Local numbering of the nodes: owned parent vertices, owned entities, then the ghosts
+        std::vector<int> new_local(n_nodes_local + n_entities, -1);
+        std::vector<Scalar> new_xpts;
+        std::vector<int> owned_idxs, ghost_idxs, ghost_owners;
+        auto add_node = [&](int node, bool owned)
+        {
+            int pos = node_pos(node);
+            new_local[pos] = static_cast<int>(new_xpts.size() / 3);
+            const Scalar *x = node >= 0 ? &xpts[node * 3] : &entity_xpts[(-node - 1) * 3];
+            new_xpts.insert(new_xpts.end(), x, x + 3);
+            int global = node >= 0 ? node_im.local_to_global(node) : entity_global[-node - 1];
+            if (owned)
+            {
+                owned_idxs.push_back(global);
+            }
+            else
+            {
+                ghost_idxs.push_back(global);
+                ghost_owners.push_back(node >= 0 ? node_ghost_owners[node - n_nodes_owned] : entity_owners[-node - 1]);
+            }
+        };
+        for (int i = 0; i < n_nodes_owned; i++)
+        {
+            add_node(i, true);
+        }
+        for (int e = 0; e < n_entities; e++)
+        {
+            if (entity_owners[e] == proc_rank)
+            {
+                add_node(-e - 1, true);
+            }
+        }
+        for (int i = n_nodes_owned; i < n_nodes_local; i++)
+        {
+            if (is_node_used[i])
+            {
+                add_node(i, false);
+            }
+        }
+        for (int e = 0; e < n_entities; e++)
+        {
+            if (entity_owners[e] != proc_rank && is_node_used[n_nodes_local + e])
+            {
+                add_node(-e - 1, false);
+            }
+        }
+
+        // Children cells, owned first, followed by the ghosts
+        std::vector<Cell> new_cells;
+        Connectivity new_conn;
+        std::vector<int> owned_cell_idxs, ghost_cell_idxs, ghost_cell_owners;
+        std::size_t pos = 0;
+        int child_idx = 0;
+        for (int c = 0; c < n_cells_local; c++)
+        {
+            const auto &children = templates.at(cells[c].type());
+            for (std::size_t k = 0; k < children.size(); k++)
+            {
+                int n_nodes = static_cast<int>(children[k].size());
+                if (is_child_kept[child_idx++])
+                {
+                    int idx = child_base[c] + static_cast<int>(k);
+                    new_cells.push_back(Cell(idx, cells[c].type(), 1, cells[c].region_tag()));
+                    new_conn.ptr.push_back(static_cast<int>(new_conn.idx.size()));
+                    new_conn.cnt.push_back(n_nodes);
+                    for (int i = 0; i < n_nodes; i++)
+                    {
+                        new_conn.idx.push_back(new_local[node_pos(child_nodes[pos + i])]);
+                    }
+                    if (c < n_cells_owned)
+                    {
+                        owned_cell_idxs.push_back(idx);
+                    }
+                    else
+                    {
+                        ghost_cell_idxs.push_back(idx);
+                        ghost_cell_owners.push_back(cell_ghost_owners[c - n_cells_owned]);
+                    }
+                }
+                pos += n_nodes;
+            }
+        }
+        new_conn.n1 = static_cast<int>(new_cells.size());
+        new_conn.n2 = static_cast<int>(new_xpts.size() / 3);
+
+        return Mesh(new_cells, new_conn, new_xpts, mesh.regions(),
+                    common::IndexMap(owned_cell_idxs, ghost_cell_idxs, ghost_cell_owners),
+                    common::IndexMap(owned_idxs, ghost_idxs, ghost_owners));
+    }
+    //=============================================================================
+    std::vector<Mesh> create_refinement_hierarchy(const Mesh &mesh, int n_refinements)
+    {
+        std::vector<Mesh> meshes;
+        meshes.reserve(n_refinements + 1);
+        meshes.push_back(mesh);
+        for (int i = 0; i < n_refinements; i++)
+        {
+            meshes.push_back(refine_uniform(meshes.back()));
+        }
+        return meshes;
+    }
+    //=============================================================================
+    Mesh create_linear_mesh(const Mesh &mesh)
+    {
+        const auto &cells = mesh.cells();
+        const auto &conn = mesh.cell_node_conn();
+        const auto &xpts = mesh.xpts();
+        const auto &node_im = mesh.node_im();
+        int n_nodes_owned = node_im.n_owned();
+        int n_nodes_local = node_im.n_local();
+        auto node_ghost_owners = node_im.get_ghost_owners();
+
+        // The vertices are listed first in each cell
+        std::vector<bool> is_vertex(n_nodes_local, false);
+        for (std::size_t c = 0; c < cells.size(); c++)
+        {
+            for (int i = 0; i < cell_nodes(cells[c].type(), 1); i++)
+            {
+                is_vertex[conn.idx[conn.ptr[c] + i]] = true;
+            }
+        }
+
+        std::vector<int> new_local(n_nodes_local, -1);
+        std::vector<Scalar> new_xpts;
+        std::vector<int> owned_idxs, ghost_idxs, ghost_owners;
+        for (int i = 0; i < n_nodes_local; i++)
+        {
+            if (!is_vertex[i])
+            {
+                continue;
+            }
+            new_local[i] = static_cast<int>(new_xpts.size() / 3);
+            new_xpts.insert(new_xpts.end(), &xpts[i * 3], &xpts[i * 3] + 3);
+            if (i < n_nodes_owned)
+            {
+                owned_idxs.push_back(node_im.local_to_global(i));
+            }
+            else
+            {
+                ghost_idxs.push_back(node_im.local_to_global(i));
+                ghost_owners.push_back(node_ghost_owners[i - n_nodes_owned]);
+            }
+        }
+
+        std::vector<Cell> new_cells;
+        Connectivity new_conn;
+        for (std::size_t c = 0; c < cells.size(); c++)
+        {
+            int n_nodes = cell_nodes(cells[c].type(), 1);
+            new_cells.push_back(Cell(cells[c].idx(), cells[c].type(), 1, cells[c].region_tag()));
+            new_conn.ptr.push_back(static_cast<int>(new_conn.idx.size()));
+            new_conn.cnt.push_back(n_nodes);
+            for (int i = 0; i < n_nodes; i++)
+            {
+                new_conn.idx.push_back(new_local[conn.idx[conn.ptr[c] + i]]);
+            }
+        }
+        new_conn.n1 = static_cast<int>(new_cells.size());
+        new_conn.n2 = static_cast<int>(new_xpts.size() / 3);
+
+        return Mesh(new_cells, new_conn, new_xpts, mesh.regions(), mesh.cell_im(),
+                    common::IndexMap(owned_idxs, ghost_idxs, ghost_owners));
+    }
+}
\ No newline at end of file
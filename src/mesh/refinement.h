@@ -0,0 +1,34 @@
+#pragma once
+
+#include "mesh.h"
+
+namespace sfem::mesh
+{
+    /// @brief Uniformly refine a (distributed) mesh, i.e. split each line into 2 children, each triangle
+    /// and quad into 4, and each tet and hex into 8
+    /// @note Only linear cells are supported. New nodes are placed at the midpoints of the edges, and at the
+    /// centroids of the quad faces and hexes. The children inherit the region tag of their parent, thus the
+    /// boundary cells (e.g. lines of a 2D mesh) remain consistent with the cells they bound
+    /// @note The refinement is performed in parallel, without repartitioning: the children are owned by the
+    /// owner of their parent, and the ghost cells (if any) are refined as well. The parent nodes keep their
+    /// global index and owner, and the new nodes are numbered after them, consistently across processes
+    /// @note The refined mesh is nested in the original one, e.g. for geometric multigrid
+    /// @note Collective
+    /// @param mesh The mesh to refine
+    /// @return The refined mesh
+    Mesh refine_uniform(const Mesh &mesh);
+
+    /// @brief Create a hierarchy of nested meshes by uniform refinement, see refine_uniform()
+    /// @param mesh The coarsest mesh
+    /// @param n_refinements Number of refinements
+    /// @return The meshes, ordered from coarsest (a copy of mesh) to finest
+    std::vector<Mesh> create_refinement_hierarchy(const Mesh &mesh, int n_refinements);
+
+    /// @brief Create the linear mesh underlying a high order mesh, i.e. with the same cells restricted
+    /// to their vertices, e.g. as the coarse level of a polynomial (p-)multigrid
+    /// @note The vertices keep their local ordering, global index and owner, and the cells their index
+    /// and region tag. A linear mesh yields an identical mesh
+    /// @param mesh The high order mesh
+    /// @return The linear mesh
+    Mesh create_linear_mesh(const Mesh &mesh);
+}
\ No newline at end of file
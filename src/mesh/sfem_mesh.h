@@ -10,4 +10,5 @@ namespace sfem::mesh
 #include "region.h"
 #include "mesh.h"
 #include "field.h"
-#include "partition.h"
\ No newline at end of file
+#include "partition.h"
+#include "refinement.h"
\ No newline at end of file
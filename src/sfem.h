@@ -21,4 +21,6 @@ namespace sfem
 
 #include "fe/sfem_fe.h"
 
+#include "solvers/sfem_solvers.h"
+
 #endif
\ No newline at end of file
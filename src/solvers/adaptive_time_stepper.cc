@@ -0,0 +1,218 @@
+#include "adaptive_time_stepper.h"
+#include "../common/logger.h"
+#include <algorithm>
+#include <cmath>
+#include <mpi.h>
+
+namespace sfem::solvers
+{
+    //=============================================================================
+    AdaptiveTimeStepper::AdaptiveTimeStepper(TimeIntegrator &integrator, Scalar rtol, Scalar atol)
+        : integrator_(integrator),
+          rtol_(rtol),
+          atol_(atol),
+          err_(la::petsc::create_vec(integrator.field().mesh(), integrator.field().n_vars()))
+    {
+        if (rtol_ < 0 || atol_ < 0 || rtol_ + atol_ <= 0)
+        {
+            Logger::instance().error("Invalid error tolerances", __FILE__, __LINE__);
+        }
+    }
+    //=============================================================================
+    TimeIntegrator &AdaptiveTimeStepper::integrator() const
+    {
+        return integrator_;
+    }
+    //=============================================================================
+    void AdaptiveTimeStepper::set_dt_limits(Scalar dt_min, Scalar dt_max)
+    {
+        if (dt_min < 0 || dt_max <= dt_min)
+        {
+            Logger::instance().error("Invalid time step limits", __FILE__, __LINE__);
+        }
+        dt_min_ = dt_min;
+        dt_max_ = dt_max;
+    }
+    //=============================================================================
+    void AdaptiveTimeStepper::set_factor_limits(Scalar min_factor, Scalar max_factor)
+    {
+        if (min_factor <= 0 || min_factor >= 1 || max_factor <= 1)
+        {
+            Logger::instance().error("Invalid time step factor limits", __FILE__, __LINE__);
+        }
+        min_factor_ = min_factor;
+        max_factor_ = max_factor;
+    }
+    //=============================================================================
+    void AdaptiveTimeStepper::set_safety_factor(Scalar safety)
+    {
+        safety_ = safety;
+    }
+    //=============================================================================
+    void AdaptiveTimeStepper::set_growth_threshold(Scalar threshold)
+    {
+        growth_threshold_ = threshold;
+    }
+    //=============================================================================
+    void AdaptiveTimeStepper::set_steady_state_tolerance(Scalar tol)
+    {
+        steady_tol_ = tol;
+    }
+    //=============================================================================
+    void AdaptiveTimeStepper::set_dt(Scalar dt)
+    {
+        if (dt <= 0)
+        {
+            Logger::instance().error("Time step must be positive, got " + std::to_string(dt), __FILE__, __LINE__);
+        }
+        dt_ = dt;
+    }
+    //=============================================================================
+    Scalar AdaptiveTimeStepper::dt() const
+    {
+        return dt_;
+    }
+    //=============================================================================
+    int AdaptiveTimeStepper::n_accepted() const
+    {
+        return n_accepted_;
+    }
+    //=============================================================================
+    int AdaptiveTimeStepper::n_rejected() const
+    {
+        return n_rejected_;
+    }
+    //=============================================================================
+    Scalar AdaptiveTimeStepper::error_norm() const
+    {
+        return error_norm_;
+    }
+    //=============================================================================
+    Scalar AdaptiveTimeStepper::rate_of_change() const
+    {
+        return rate_;
+    }
+    //=============================================================================
+    bool AdaptiveTimeStepper::is_steady() const
+    {
+        return steady_tol_ > 0 && rate_ < steady_tol_;
+    }
+    //=============================================================================
+    Scalar AdaptiveTimeStepper::step(Scalar dt_max)
+    {
+        if (dt_ <= 0)
+        {
+            Logger::instance().error("Initial time step has not been set", __FILE__, __LINE__);
+        }
+
+        auto &field = integrator_.field();
+        Scalar exponent = -1.0 / (integrator_.order() + 1);
+
+        for (int n_tries = 1;; n_tries++)
+        {
+            Scalar dt = std::min({dt_, dt_max, dt_max_});
+
+            integrator_.save_state();
+            u_prev_.assign(field.values().cbegin(), field.values().cbegin() + field.n_dof_owned());
+            integrator_.take_step(dt);
+
+            error_norm_ = integrator_.estimate_error(err_) ? compute_error_norm(err_) : -1;
+
+            // Reject the step and retry with a smaller time step
+            if ((error_norm_ > 1 || std::isnan(error_norm_)) && dt > dt_min_)
+            {
+                if (n_tries == max_tries_)
+                {
+                    Logger::instance().error("Time step rejected " + std::to_string(n_tries) + " times at time " +
+                                                 std::to_string(integrator_.time()),
+                                             __FILE__, __LINE__);
+                }
+                integrator_.restore_state();
+                n_rejected_++;
+                Scalar factor = min_factor_;
+                if (!std::isnan(error_norm_))
+                {
+                    factor = std::max(min_factor_, safety_ * std::pow(error_norm_, exponent));
+                }
+                dt_ = std::max(dt * factor, dt_min_);
+                continue;
+            }
+            if (error_norm_ > 1)
+            {
+                Logger::instance().warn("Error tolerance not met with the minimum time step", __FILE__, __LINE__);
+            }
+
+            // Accept the step, and only grow the time step by a significant factor,
+            // so that the effective operator is re-formed as seldom as possible
+            n_accepted_++;
+            rate_ = compute_rate_of_change(dt);
+            if (error_norm_ >= 0)
+            {
+                Scalar factor = error_norm_ > 0 ? safety_ * std::pow(error_norm_, exponent) : max_factor_;
+                if (factor >= growth_threshold_)
+                {
+                    dt_ = std::max(dt_, std::min(dt * std::min(factor, max_factor_), dt_max_));
+                }
+            }
+
+            integrator_.notify_monitor();
+            return dt;
+        }
+    }
+    //=============================================================================
+    bool AdaptiveTimeStepper::solve(Scalar t_end, Scalar dt)
+    {
+        set_dt(dt);
+
+        const Scalar tol = 1e-10 * dt;
+        while (t_end - integrator_.time() > tol)
+        {
+            step(t_end - integrator_.time());
+            if (is_steady())
+            {
+                Logger::instance().info("Steady state reached at time " + std::to_string(integrator_.time()) + "\n");
+                return true;
+            }
+        }
+        return false;
+    }
+    //=============================================================================
+    Scalar AdaptiveTimeStepper::compute_error_norm(const la::petsc::PetscVec &err) const
+    {
+        auto &field = integrator_.field();
+        const auto &values = field.values();
+
+        const Scalar *err_values;
+        VecGetArrayRead(err.vec(), &err_values);
+        Scalar sum = 0;
+        for (int i = 0; i < field.n_dof_owned(); i++)
+        {
+            Scalar e = err_values[i] / (atol_ + rtol_ * std::abs(values[i]));
+            sum += e * e;
+        }
+        VecRestoreArrayRead(err.vec(), &err_values);
+
+        Scalar sum_global;
+        MPI_Allreduce(&sum, &sum_global, 1, SFEM_MPI_FLOAT, MPI_SUM, SFEM_COMM_WORLD);
+        return std::sqrt(sum_global / field.n_dof_global());
+    }
+    //=============================================================================
+    Scalar AdaptiveTimeStepper::compute_rate_of_change(Scalar dt) const
+    {
+        auto &field = integrator_.field();
+        const auto &values = field.values();
+
+        Scalar sums[2] = {0, 0};
+        for (int i = 0; i < field.n_dof_owned(); i++)
+        {
+            Scalar du = values[i] - u_prev_[i];
+            sums[0] += du * du;
+            sums[1] += values[i] * values[i];
+        }
+
+        Scalar sums_global[2];
+        MPI_Allreduce(sums, sums_global, 2, SFEM_MPI_FLOAT, MPI_SUM, SFEM_COMM_WORLD);
+        Scalar norm = sums_global[1] > 0 ? std::sqrt(sums_global[1]) : 1;
+        return std::sqrt(sums_global[0]) / (dt * norm);
+    }
+}
\ No newline at end of file
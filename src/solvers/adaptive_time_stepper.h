@@ -0,0 +1,137 @@
+#pragma once
+
+#ifdef SFEM_HAS_PETSC
+
+#include "time_integrator.h"
+#include <limits>
+
+namespace sfem::solvers
+{
+    /// @brief Adaptive time step controller for a TimeIntegrator
+    /// @note After each step, the local truncation error estimate of the integrator is measured in
+    /// the weighted RMS norm ||e / (atol + rtol |u|)||. Steps with a norm larger than one are rejected
+    /// and repeated with a smaller time step. For accepted steps, the time step is only increased if the
+    /// proposed growth factor exceeds a threshold, so that the effective operator (and its factorisation
+    /// or preconditioner) is reused over many steps
+    /// @note Optionally, the integration is stopped once a steady state is reached, i.e. when the relative
+    /// rate of change of the field values ||u_{n+1} - u_n|| / (dt ||u_{n+1}||) drops below a tolerance
+    class AdaptiveTimeStepper
+    {
+    public:
+        /// @brief Create an AdaptiveTimeStepper
+        /// @param integrator The time integrator
+        /// @param rtol Relative error tolerance
+        /// @param atol Absolute error tolerance
+        AdaptiveTimeStepper(TimeIntegrator &integrator, Scalar rtol = 1e-3, Scalar atol = 1e-6);
+
+        /// @brief Get the time integrator
+        TimeIntegrator &integrator() const;
+
+        /// @brief Set the minimum and maximum time step
+        void set_dt_limits(Scalar dt_min, Scalar dt_max);
+
+        /// @brief Set the limits of the time step change factor per step
+        /// @param min_factor Smallest factor, applied when a step is rejected
+        /// @param max_factor Largest factor, applied when a step is accepted
+        void set_factor_limits(Scalar min_factor, Scalar max_factor);
+
+        /// @brief Set the safety factor applied to the optimal time step
+        void set_safety_factor(Scalar safety);
+
+        /// @brief Set the growth threshold, i.e. the time step of accepted steps is kept unchanged
+        /// unless it may be increased by at least this factor
+        void set_growth_threshold(Scalar threshold);
+
+        /// @brief Set the steady state tolerance for the relative rate of change of the field values
+        /// @note A non-positive value disables the steady state detection (default)
+        void set_steady_state_tolerance(Scalar tol);
+
+        /// @brief Set the time step to be attempted next
+        void set_dt(Scalar dt);
+
+        /// @brief Get the time step to be attempted next
+        Scalar dt() const;
+
+        /// @brief Get the number of accepted steps
+        int n_accepted() const;
+
+        /// @brief Get the number of rejected steps
+        int n_rejected() const;
+
+        /// @brief Get the weighted RMS norm of the error estimate of the last step
+        /// @note -1 if no estimate was available
+        Scalar error_norm() const;
+
+        /// @brief Get the relative rate of change of the field values for the last step
+        Scalar rate_of_change() const;
+
+        /// @brief Whether a steady state has been reached
+        bool is_steady() const;
+
+        /// @brief Take a single, accepted, step, retrying with smaller time steps if required
+        /// @note The initial time step must have been set, see set_dt()
+        /// @note An error is raised if the step is still rejected after repeatedly reducing the time step
+        /// @param dt_max Upper bound for the time step, e.g. to exactly reach an output time
+        /// @return The time step that was taken
+        Scalar step(Scalar dt_max);
+
+        /// @brief Advance the solution up to a final time, or until a steady state is reached
+        /// @param t_end Final time
+        /// @param dt Initial time step
+        /// @return Whether a steady state was reached
+        bool solve(Scalar t_end, Scalar dt);
+
+    private:
+        /// @brief Compute the weighted RMS norm of the error estimate
+        Scalar compute_error_norm(const la::petsc::PetscVec &err) const;
+
+        /// @brief Compute the relative rate of change of the owned field values
+        Scalar compute_rate_of_change(Scalar dt) const;
+
+        /// @brief Time integrator
+        TimeIntegrator &integrator_;
+
+        /// @brief Error tolerances
+        Scalar rtol_;
+        Scalar atol_;
+
+        /// @brief Time step limits
+        Scalar dt_min_ = 0;
+        Scalar dt_max_ = std::numeric_limits<Scalar>::max();
+
+        /// @brief Time step change factor limits
+        Scalar min_factor_ = 0.2;
+        Scalar max_factor_ = 2.0;
+
+        /// @brief Safety factor
+        Scalar safety_ = 0.9;
+
+        /// @brief Growth threshold
+        Scalar growth_threshold_ = 1.5;
+
+        /// @brief Steady state tolerance
+        Scalar steady_tol_ = 0;
+
+        /// @brief Current time step
+        Scalar dt_ = 0;
+
+        /// @brief Maximum number of attempts for a single step
+        static constexpr int max_tries_ = 25;
+
+        /// @brief Step counters
+        int n_accepted_ = 0;
+        int n_rejected_ = 0;
+
+        /// @brief Error norm and rate of change for the last step
+        Scalar error_norm_ = -1;
+        Scalar rate_ = std::numeric_limits<Scalar>::max();
+
+        /// @brief Error estimate
+        la::petsc::PetscVec err_;
+
+        /// @brief Owned field values before the last step
+        std::vector<Scalar> u_prev_;
+    };
+}
+
+#endif // SFEM_HAS_PETSC
\ No newline at end of file
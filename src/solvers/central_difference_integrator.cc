@@ -0,0 +1,120 @@
+#include "central_difference_integrator.h"
+#include "../common/logger.h"
+#include "../common/error.h"
+#include <cmath>
+
+namespace sfem::solvers
+{
+    //=============================================================================
+    CentralDifferenceIntegrator::CentralDifferenceIntegrator(const std::vector<std::shared_ptr<fe::FiniteElement>> &elems,
+                                                             mesh::Field &field,
+                                                             fe::MatrixLumping lumping,
+                                                             Scalar time)
+        : ExplicitIntegrator(elems, field, lumping, time),
+          damping_(field.n_dof_local(), 0.0),
+          u_(field.values()),
+          v_(field.n_dof_local(), 0.0),
+          a_(field.n_dof_local(), 0.0)
+    {
+        compute_acceleration(time_);
+    }
+    //=============================================================================
+    void CentralDifferenceIntegrator::add_damping(Scalar a, bool include_elements)
+    {
+        std::vector<Scalar> elem_damping(field_.n_dof_local(), 0.0);
+        if (include_elements)
+        {
+            fe::assemble_lumped_matrix(elems_, field_, fe::FEMatrixType::damping, fe::MatrixLumping::row_sum,
+                                       elem_damping, time_);
+        }
+        for (int i = 0; i < field_.n_dof_owned(); i++)
+        {
+            damping_[i] += a * mass_[i] + elem_damping[i];
+        }
+
+        compute_acceleration(time_);
+    }
+    //=============================================================================
+    void CentralDifferenceIntegrator::set_initial_velocity(const std::vector<Scalar> &values)
+    {
+        if (values.size() != static_cast<std::size_t>(field_.n_dof_owned()))
+        {
+            error::invalid_size_error(field_.n_dof_owned(), values.size(), __FILE__, __LINE__);
+        }
+        for (int i = 0; i < field_.n_dof_owned(); i++)
+        {
+            v_[i] = is_fixed_[i] ? 0 : values[i];
+        }
+
+        compute_acceleration(time_);
+    }
+    //=============================================================================
+    const std::vector<Scalar> &CentralDifferenceIntegrator::velocity() const
+    {
+        return v_;
+    }
+    //=============================================================================
+    const std::vector<Scalar> &CentralDifferenceIntegrator::acceleration() const
+    {
+        return a_;
+    }
+    //=============================================================================
+    void CentralDifferenceIntegrator::update_fixed_dof()
+    {
+        ExplicitIntegrator::update_fixed_dof();
+
+        u_ = field_.values();
+        for (int i = 0; i < field_.n_dof_owned(); i++)
+        {
+            if (is_fixed_[i])
+            {
+                v_[i] = 0;
+            }
+        }
+        compute_acceleration(time_);
+    }
+    //=============================================================================
+    int CentralDifferenceIntegrator::order() const
+    {
+        return 2;
+    }
+    //=============================================================================
+    Scalar CentralDifferenceIntegrator::stable_dt() const
+    {
+        return 2.0 / std::sqrt(max_eigenvalue());
+    }
+    //=============================================================================
+    void CentralDifferenceIntegrator::take_step(Scalar dt)
+    {
+        if (dt <= 0)
+        {
+            Logger::instance().error("Time step must be positive, got " + std::to_string(dt), __FILE__, __LINE__);
+        }
+
+        // Half-step velocity and new displacement
+        for (int i = 0; i < field_.n_dof_owned(); i++)
+        {
+            v_[i] += 0.5 * dt * a_[i];
+            u_[i] += dt * v_[i];
+        }
+
+        // New acceleration, with the damping evaluated at the half-step velocity
+        compute_forces(time_ + dt, u_, f_);
+        for (int i = 0; i < field_.n_dof_owned(); i++)
+        {
+            a_[i] = (f_[i] - damping_[i] * v_[i]) / mass_[i];
+            v_[i] += 0.5 * dt * a_[i];
+        }
+
+        complete_step(dt, u_);
+    }
+    //=============================================================================
+    void CentralDifferenceIntegrator::compute_acceleration(Scalar time)
+    {
+        compute_forces(time, u_, f_);
+        for (int i = 0; i < field_.n_dof_owned(); i++)
+        {
+            a_[i] = (f_[i] - damping_[i] * v_[i]) / mass_[i];
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "explicit_integrator.h"
+
+namespace sfem::solvers
+{
+    /// @brief Explicit central difference integrator for second order systems of the form
+    /// M u'' + C u' + R(u, t) = F(t), e.g. structural dynamics under impact loads
+    /// @note The scheme is implemented in its half-step velocity form (explicit Newmark, beta = 0, gamma = 1/2):
+    /// v_{n+1/2} = v_n + dt/2 a_n, u_{n+1} = u_n + dt v_{n+1/2}, a_{n+1} = M^-1 (F - R(u_{n+1}) - C v_{n+1/2}),
+    /// v_{n+1} = v_{n+1/2} + dt/2 a_{n+1}, i.e. a single internal force evaluation per step.
+    /// The damping force is lagged by half a step, so that C may be any (lumped) matrix
+    /// @note Stable for dt <= 2 / omega_max, where omega_max^2 is the largest eigenvalue of M^-1 K
+    class CentralDifferenceIntegrator : public ExplicitIntegrator
+    {
+    public:
+        /// @brief Create a CentralDifferenceIntegrator
+        /// @note The initial acceleration is computed from the equation of motion at the initial time
+        /// @param elems The contributing elements
+        /// @param field The solution (displacement) field. Its current values are used as initial condition
+        /// @param lumping Mass lumping method
+        /// @param time Initial time
+        CentralDifferenceIntegrator(const std::vector<std::shared_ptr<fe::FiniteElement>> &elems,
+                                    mesh::Field &field,
+                                    fe::MatrixLumping lumping = fe::MatrixLumping::diagonal_scaling,
+                                    Scalar time = 0);
+
+        /// @brief Add lumped damping, i.e. C += a M + C_e, where C_e is the
+        /// lumped damping matrix of the elements, if include_elements is set
+        void add_damping(Scalar a, bool include_elements = false);
+
+        /// @brief Set the initial velocity
+        /// @param values Owned velocity values, laid out as the Field values
+        void set_initial_velocity(const std::vector<Scalar> &values);
+
+        /// @brief Get the current velocity, for the owned DoF
+        const std::vector<Scalar> &velocity() const;
+
+        /// @brief Get the current acceleration, for the owned DoF
+        const std::vector<Scalar> &acceleration() const;
+
+        /// @brief Re-read the fixed DoF of the field, and update the acceleration accordingly
+        void update_fixed_dof() override;
+
+        /// @brief Get the order of accuracy of the time integration scheme
+        int order() const override;
+
+        /// @brief Estimate the critical time step, i.e. 2 / omega_max
+        Scalar stable_dt() const override;
+
+        /// @brief Advance the solution by a single time step, without invoking the monitor
+        /// @param dt Time step
+        void take_step(Scalar dt) override;
+
+    private:
+        /// @brief Compute the acceleration from the equation of motion
+        void compute_acceleration(Scalar time);
+
+        /// @brief Lumped damping (local DoF)
+        std::vector<Scalar> damping_;
+
+        /// @brief Displacement, velocity, acceleration and net forces (local DoF)
+        std::vector<Scalar> u_;
+        std::vector<Scalar> v_;
+        std::vector<Scalar> a_;
+        std::vector<Scalar> f_;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,180 @@
+#include "explicit_integrator.h"
+#include "../common/logger.h"
+#include <algorithm>
+#include <mpi.h>
+
+namespace sfem::solvers
+{
+    //=============================================================================
+    ExplicitIntegrator::ExplicitIntegrator(const std::vector<std::shared_ptr<fe::FiniteElement>> &elems,
+                                           mesh::Field &field,
+                                           fe::MatrixLumping lumping,
+                                           Scalar time)
+        : elems_(elems),
+          field_(field),
+          time_(time),
+          lumping_(lumping),
+          mass_(field.n_dof_local(), 0.0),
+          loads_(field.n_dof_local(), 0.0)
+    {
+        if (lumping_ == fe::MatrixLumping::absolute_row_sum)
+        {
+            Logger::instance().error("Absolute row sum lumping is not a valid mass lumping", __FILE__, __LINE__);
+        }
+
+        fe::assemble_lumped_matrix(elems_, field_, fe::FEMatrixType::mass, lumping_, mass_, time_);
+        for (int i = 0; i < field_.n_dof_owned(); i++)
+        {
+            if (mass_[i] <= 0)
+            {
+                Logger::instance().error("Non-positive lumped mass for DoF " + std::to_string(i) +
+                                             ". Use diagonal scaling lumping for higher order elements",
+                                         __FILE__, __LINE__);
+            }
+        }
+
+        update_fixed_dof();
+    }
+    //=============================================================================
+    Scalar ExplicitIntegrator::time() const
+    {
+        return time_;
+    }
+    //=============================================================================
+    int ExplicitIntegrator::n_steps() const
+    {
+        return n_steps_;
+    }
+    //=============================================================================
+    mesh::Field &ExplicitIntegrator::field() const
+    {
+        return field_;
+    }
+    //=============================================================================
+    const std::vector<Scalar> &ExplicitIntegrator::lumped_mass() const
+    {
+        return mass_;
+    }
+    //=============================================================================
+    void ExplicitIntegrator::set_load_callback(LoadCallback callback)
+    {
+        load_callback_ = callback;
+    }
+    //=============================================================================
+    void ExplicitIntegrator::set_monitor(MonitorCallback callback)
+    {
+        monitor_ = callback;
+    }
+    //=============================================================================
+    void ExplicitIntegrator::update_fixed_dof()
+    {
+        std::tie(is_fixed_, fixed_values_) = fe::get_fixed_dof_mask(field_);
+
+        // Enforce the fixed values on the current solution
+        auto &values = field_.values();
+        for (int i = 0; i < field_.n_dof_local(); i++)
+        {
+            if (is_fixed_[i])
+            {
+                values[i] = fixed_values_[i];
+            }
+        }
+    }
+    //=============================================================================
+    void ExplicitIntegrator::set_safety_factor(Scalar safety)
+    {
+        if (safety <= 0 || safety > 1)
+        {
+            Logger::instance().error("Invalid safety factor " + std::to_string(safety), __FILE__, __LINE__);
+        }
+        safety_ = safety;
+    }
+    //=============================================================================
+    void ExplicitIntegrator::advance(Scalar dt)
+    {
+        take_step(dt);
+        notify_monitor();
+    }
+    //=============================================================================
+    void ExplicitIntegrator::notify_monitor() const
+    {
+        if (monitor_)
+        {
+            monitor_(n_steps_, time_, field_);
+        }
+    }
+    //=============================================================================
+    void ExplicitIntegrator::solve(Scalar t_end, Scalar dt)
+    {
+        if (dt <= 0)
+        {
+            dt = safety_ * stable_dt();
+            Logger::instance().info("Explicit time step " + std::to_string(dt) + "\n");
+        }
+
+        const Scalar tol = 1e-10 * dt;
+        while (t_end - time_ > tol)
+        {
+            advance(std::min(dt, t_end - time_));
+        }
+    }
+    //=============================================================================
+    void ExplicitIntegrator::compute_forces(Scalar time, const std::vector<Scalar> &u, std::vector<Scalar> &f)
+    {
+        auto &values = field_.values();
+        if (&u != &values)
+        {
+            std::copy(u.cbegin(), u.cbegin() + field_.n_dof_owned(), values.begin());
+        }
+        field_.update_ghosts();
+
+        // Internal forces, i.e. the element residuals, with the ghost contributions summed to their owners
+        f.assign(field_.n_dof_local(), 0.0);
+        fe::assemble_vector_local(elems_, field_, fe::FEVectorType::residual, f, time);
+
+        // External forces, zero without a callback
+        if (load_callback_)
+        {
+            std::fill(loads_.begin(), loads_.end(), 0.0);
+            load_callback_(time, loads_);
+        }
+
+        for (int i = 0; i < field_.n_dof_owned(); i++)
+        {
+            f[i] = is_fixed_[i] ? 0 : loads_[i] - f[i];
+        }
+    }
+    //=============================================================================
+    Scalar ExplicitIntegrator::max_eigenvalue() const
+    {
+        std::vector<Scalar> row_sums(field_.n_dof_local(), 0.0);
+        fe::assemble_lumped_matrix(elems_, field_, fe::FEMatrixType::jacobian,
+                                   fe::MatrixLumping::absolute_row_sum, row_sums, time_);
+
+        Scalar lambda = 0;
+        for (int i = 0; i < field_.n_dof_owned(); i++)
+        {
+            if (!is_fixed_[i])
+            {
+                lambda = std::max(lambda, row_sums[i] / mass_[i]);
+            }
+        }
+
+        Scalar lambda_global;
+        MPI_Allreduce(&lambda, &lambda_global, 1, SFEM_MPI_FLOAT, MPI_MAX, SFEM_COMM_WORLD);
+        return lambda_global;
+    }
+    //=============================================================================
+    void ExplicitIntegrator::complete_step(Scalar dt, const std::vector<Scalar> &u)
+    {
+        time_ += dt;
+        n_steps_++;
+
+        auto &values = field_.values();
+        for (int i = 0; i < field_.n_dof_owned(); i++)
+        {
+            values[i] = is_fixed_[i] ? fixed_values_[i] : u[i];
+        }
+        field_.update_ghosts();
+    }
+}
\ No newline at end of file
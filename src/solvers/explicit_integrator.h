@@ -0,0 +1,147 @@
+#pragma once
+
+#include "../fe/finite_element.h"
+#include "../fe/utils/assembly.h"
+#include <functional>
+#include <memory>
+
+namespace sfem::solvers
+{
+    /// @brief Base class for explicit time integrators of semi-discrete systems of the form
+    /// M u'' + C u' + R(u, t) = F(t) (or M u' + R(u, t) = F(t) for first order problems),
+    /// where R is the residual of the elements, i.e. K u minus their own loads for linear elements
+    /// @note M (and C) are lumped into diagonals, thus no global matrix is assembled and no linear system
+    /// is solved. The internal forces R are evaluated element by element from the current field values,
+    /// and the ghost contributions are summed to their owners with the Field's GhostExchange
+    /// @note The fixed DoF are enforced at each step, i.e. their rates are zero
+    /// @note The time step must be below the stability limit of the scheme, see stable_dt()
+    class ExplicitIntegrator
+    {
+    public:
+        /// @brief Callback used to add external forces at a given time
+        /// @note F holds the local DoF values (owned + ghost), laid out as the Field values, of which only
+        /// the owned entries are used. It is zeroed before the callback is invoked
+        using LoadCallback = std::function<void(Scalar time, std::vector<Scalar> &F)>;
+
+        /// @brief Callback invoked after each completed time step
+        using MonitorCallback = std::function<void(int step, Scalar time, const mesh::Field &field)>;
+
+        /// @brief Create an ExplicitIntegrator
+        /// @param elems The contributing elements
+        /// @param field The solution field. Its current values are used as initial condition
+        /// @param lumping Mass lumping method
+        /// @param time Initial time
+        ExplicitIntegrator(const std::vector<std::shared_ptr<fe::FiniteElement>> &elems,
+                           mesh::Field &field,
+                           fe::MatrixLumping lumping = fe::MatrixLumping::diagonal_scaling,
+                           Scalar time = 0);
+
+        // Copy constructor (deleted)
+        ExplicitIntegrator(const ExplicitIntegrator &) = delete;
+
+        // Copy assignment (deleted)
+        ExplicitIntegrator &operator=(const ExplicitIntegrator &) = delete;
+
+        /// @brief Destructor
+        virtual ~ExplicitIntegrator() = default;
+
+        /// @brief Get the current time
+        Scalar time() const;
+
+        /// @brief Get the number of completed time steps
+        int n_steps() const;
+
+        /// @brief Get the solution field
+        mesh::Field &field() const;
+
+        /// @brief Get the lumped mass, for the local DoF
+        /// @note Only the owned entries are valid
+        const std::vector<Scalar> &lumped_mass() const;
+
+        /// @brief Set the callback used to add external forces
+        /// @note The elements' loads are always included, through their residuals
+        void set_load_callback(LoadCallback callback);
+
+        /// @brief Set the callback invoked after each completed time step, e.g. to write output
+        void set_monitor(MonitorCallback callback);
+
+        /// @brief Re-read the fixed DoF of the field
+        /// @note Call after the field's fixed DoF have been modified
+        virtual void update_fixed_dof();
+
+        /// @brief Get the order of accuracy of the time integration scheme
+        virtual int order() const = 0;
+
+        /// @brief Estimate the critical time step of the scheme, for the current field values
+        /// @note The largest eigenvalue of M^-1 K is bounded by Gershgorin's theorem, using the
+        /// absolute row sums of the element Jacobian matrices, thus the estimate is conservative
+        /// @note Collective, i.e. the minimum over all processes is returned
+        virtual Scalar stable_dt() const = 0;
+
+        /// @brief Set the safety factor applied to the critical time step by solve()
+        void set_safety_factor(Scalar safety);
+
+        /// @brief Advance the solution by a single time step, and invoke the monitor
+        /// @param dt Time step
+        void advance(Scalar dt);
+
+        /// @brief Advance the solution by a single time step, without invoking the monitor
+        /// @param dt Time step
+        virtual void take_step(Scalar dt) = 0;
+
+        /// @brief Invoke the monitor, if set, for the current step
+        void notify_monitor() const;
+
+        /// @brief Advance the solution up to a final time, using a constant time step
+        /// @note The last step is shortened, if required, to exactly reach the final time
+        /// @param t_end Final time
+        /// @param dt Time step. If not positive, the critical time step times the safety factor is used
+        void solve(Scalar t_end, Scalar dt = 0);
+
+    protected:
+        /// @brief Compute the net forces F(t) - R(u, t) for the given local values u
+        /// @note The field values are set to u, and their ghosts updated
+        /// @note On return, only the owned entries of f are valid, and zero for the fixed DoF
+        void compute_forces(Scalar time, const std::vector<Scalar> &u, std::vector<Scalar> &f);
+
+        /// @brief Bound the largest eigenvalue of M^-1 K, where K is the Jacobian matrix
+        Scalar max_eigenvalue() const;
+
+        /// @brief Finish a time step: update the time, and the field values with their ghosts
+        void complete_step(Scalar dt, const std::vector<Scalar> &u);
+
+        /// @brief Contributing elements
+        std::vector<std::shared_ptr<fe::FiniteElement>> elems_;
+
+        /// @brief Solution field
+        mesh::Field &field_;
+
+        /// @brief Current time
+        Scalar time_;
+
+        /// @brief Number of completed time steps
+        int n_steps_ = 0;
+
+        /// @brief Mass lumping method
+        fe::MatrixLumping lumping_;
+
+        /// @brief Lumped mass (local DoF)
+        std::vector<Scalar> mass_;
+
+        /// @brief Whether each local DoF is fixed, and the fixed values
+        std::vector<bool> is_fixed_;
+        std::vector<Scalar> fixed_values_;
+
+        /// @brief Safety factor applied to the critical time step
+        Scalar safety_ = 0.9;
+
+        /// @brief External forces (local DoF)
+        std::vector<Scalar> loads_;
+
+        /// @brief User-supplied load callback
+        LoadCallback load_callback_;
+
+        /// @brief User-supplied monitor
+        MonitorCallback monitor_;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,178 @@
+#include "first_order_integrator.h"
+#include "../common/timer.h"
+#include "../common/logger.h"
+#include <cmath>
+
+namespace sfem::solvers
+{
+    //=============================================================================
+    FirstOrderIntegrator::FirstOrderIntegrator(const std::vector<std::shared_ptr<fe::FiniteElement>> &elems,
+                                               mesh::Field &field,
+                                               FirstOrderScheme scheme,
+                                               Scalar time)
+        : TimeIntegrator(elems, field, time),
+          scheme_(scheme),
+          u_(la::petsc::create_vec(field.mesh(), field.n_vars())),
+          u_prev_(u_.copy()),
+          u_prev2_(u_.copy()),
+          u_pred_(u_.copy()),
+          F_(u_.copy()),
+          F_prev_(u_.copy()),
+          rhs_(u_.copy()),
+          work_(u_.copy())
+    {
+        la::petsc::field_to_vec(field_, u_);
+    }
+    //=============================================================================
+    FirstOrderScheme FirstOrderIntegrator::scheme() const
+    {
+        return scheme_;
+    }
+    //=============================================================================
+    int FirstOrderIntegrator::order() const
+    {
+        return scheme_ == FirstOrderScheme::implicit_euler ? 1 : 2;
+    }
+    //=============================================================================
+    int FirstOrderIntegrator::take_step(Scalar dt)
+    {
+        common::Timer timer("Time step");
+
+        // Order of this step, and constant of its leading error term, i.e. u(t_{n+1}) - u_{n+1} = c_c u^(p+1)
+        int step_order = order();
+        Scalar c_c = 0;
+
+        compute_load(time_ + dt, F_);
+
+        // BDF2 requires one previous solution, thus the first step is taken with implicit Euler
+        if (scheme_ == FirstOrderScheme::bdf2 && n_steps_ > 0)
+        {
+            // Variable step BDF2, with w = dt_{n+1}/dt_n:
+            // ((1+2w)/((1+w)dt) M + K) u_{n+1} = F_{n+1} + M ((1+w)/dt u_n - w^2/((1+w)dt) u_{n-1})
+            Scalar w = dt / dt_prev_;
+            Scalar a0 = (1 + 2 * w) / ((1 + w) * dt);
+            Scalar a1 = -(1 + w) / dt;
+            Scalar a2 = w * w / ((1 + w) * dt);
+            update_operator(a0, 0, 1);
+            c_c = (a1 * std::pow(-dt, 3) + a2 * std::pow(-dt - dt_prev_, 3)) / (6 * a0);
+
+            la::petsc::vec_copy(u_, work_);
+            la::petsc::vec_axpby(-w * w / ((1 + w) * dt), u_prev_, (1 + w) / dt, work_);
+            la::petsc::mat_mult_add(*M_, work_, F_, rhs_);
+        }
+        else
+        {
+            // Theta method:
+            // (M/dt + theta K) u_{n+1} = M/dt u_n - (1-theta) K u_n + theta F_{n+1} + (1-theta) F_n
+            Scalar theta = scheme_ == FirstOrderScheme::crank_nicolson ? 0.5 : 1.0;
+            update_operator(1 / dt, 0, theta);
+            step_order = theta < 1 ? 2 : 1;
+            c_c = theta < 1 ? -std::pow(dt, 3) / 12 : -dt * dt / 2;
+
+            la::petsc::mat_mult(*M_, u_, rhs_);
+            la::petsc::vec_scale(1 / dt, rhs_);
+            la::petsc::vec_axpy(theta, F_, rhs_);
+            if (theta < 1)
+            {
+                if (!has_prev_load_)
+                {
+                    compute_load(time_, F_prev_);
+                }
+                la::petsc::mat_mult(*K_, u_, work_);
+                la::petsc::vec_axpy(-(1 - theta), work_, rhs_);
+                la::petsc::vec_axpy(1 - theta, F_prev_, rhs_);
+            }
+        }
+
+        // Predictor, i.e. extrapolation of the last step_order + 1 solutions,
+        // and constant of its leading error term c_p
+        Scalar c_p = 0;
+        if (n_steps_ >= step_order)
+        {
+            Scalar h = dt, h1 = dt_prev_, h2 = dt_prev2_;
+            if (step_order == 1)
+            {
+                la::petsc::vec_copy(u_, u_pred_);
+                la::petsc::vec_axpby(-h / h1, u_prev_, 1 + h / h1, u_pred_);
+                c_p = h * (h + h1) / 2;
+            }
+            else
+            {
+                la::petsc::vec_copy(u_, u_pred_);
+                la::petsc::vec_scale((h + h1) * (h + h1 + h2) / (h1 * (h1 + h2)), u_pred_);
+                la::petsc::vec_axpy(-h * (h + h1 + h2) / (h1 * h2), u_prev_, u_pred_);
+                la::petsc::vec_axpy(h * (h + h1) / ((h1 + h2) * h2), u_prev2_, u_pred_);
+                c_p = h * (h + h1) * (h + h1 + h2) / 6;
+            }
+        }
+
+        // Store the history and solve for the new solution,
+        // using the predictor (or the current solution) as initial guess
+        std::swap(u_prev_, u_prev2_);
+        la::petsc::vec_copy(u_, u_prev_);
+        if (c_p != 0)
+        {
+            la::petsc::vec_copy(u_pred_, u_);
+        }
+        int n_iter = solve_step(rhs_, u_);
+
+        // Milne's device: u_{n+1} - u_pred ~ (c_p - c_c) u^(p+1)
+        error_factor_ = c_p != 0 ? c_c / (c_p - c_c) : 0;
+
+        std::swap(F_, F_prev_);
+        has_prev_load_ = true;
+        dt_prev2_ = dt_prev_;
+        dt_prev_ = dt;
+        complete_step(dt, u_);
+
+        return n_iter;
+    }
+    //=============================================================================
+    bool FirstOrderIntegrator::estimate_error(la::petsc::PetscVec &err) const
+    {
+        if (error_factor_ == 0)
+        {
+            return false;
+        }
+        la::petsc::vec_copy(u_, err);
+        la::petsc::vec_axpby(-error_factor_, u_pred_, error_factor_, err);
+        return true;
+    }
+    //=============================================================================
+    void FirstOrderIntegrator::save_state()
+    {
+        TimeIntegrator::save_state();
+        if (saved_vecs_.empty())
+        {
+            for (int i = 0; i < 4; i++)
+            {
+                saved_vecs_.push_back(u_.copy());
+            }
+        }
+        la::petsc::vec_copy(u_, saved_vecs_[0]);
+        la::petsc::vec_copy(u_prev_, saved_vecs_[1]);
+        la::petsc::vec_copy(u_prev2_, saved_vecs_[2]);
+        la::petsc::vec_copy(F_prev_, saved_vecs_[3]);
+        saved_dt_prev_ = dt_prev_;
+        saved_dt_prev2_ = dt_prev2_;
+        saved_has_prev_load_ = has_prev_load_;
+    }
+    //=============================================================================
+    void FirstOrderIntegrator::restore_state()
+    {
+        if (saved_vecs_.empty())
+        {
+            Logger::instance().error("No state has been saved", __FILE__, __LINE__);
+        }
+        TimeIntegrator::restore_state();
+        la::petsc::vec_copy(saved_vecs_[0], u_);
+        la::petsc::vec_copy(saved_vecs_[1], u_prev_);
+        la::petsc::vec_copy(saved_vecs_[2], u_prev2_);
+        la::petsc::vec_copy(saved_vecs_[3], F_prev_);
+        dt_prev_ = saved_dt_prev_;
+        dt_prev2_ = saved_dt_prev2_;
+        has_prev_load_ = saved_has_prev_load_;
+        error_factor_ = 0;
+        la::petsc::vec_to_field(u_, field_);
+    }
+}
\ No newline at end of file
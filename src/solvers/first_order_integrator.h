@@ -0,0 +1,96 @@
+#pragma once
+
+#ifdef SFEM_HAS_PETSC
+
+#include "time_integrator.h"
+
+namespace sfem::solvers
+{
+    /// @brief Time integration schemes for first order systems
+    enum class FirstOrderScheme
+    {
+        implicit_euler = 0,
+        crank_nicolson = 1,
+        bdf2 = 2
+    };
+
+    /// @brief Implicit time integrator for first order systems of the form M u' + K u = F(t),
+    /// e.g. transient heat conduction
+    /// @note BDF2 supports variable time steps, and is started with an implicit Euler step
+    /// @note The local truncation error is estimated by comparing the solution with an explicit
+    /// predictor of the same order, i.e. an extrapolation of the previous solutions (Milne's device).
+    /// The predictor is also used as initial guess for the linear solver
+    class FirstOrderIntegrator : public TimeIntegrator
+    {
+    public:
+        /// @brief Create a FirstOrderIntegrator
+        /// @param elems The contributing elements
+        /// @param field The solution field. Its current values are used as initial condition
+        /// @param scheme Time integration scheme
+        /// @param time Initial time
+        FirstOrderIntegrator(const std::vector<std::shared_ptr<fe::FiniteElement>> &elems,
+                             mesh::Field &field,
+                             FirstOrderScheme scheme = FirstOrderScheme::bdf2,
+                             Scalar time = 0);
+
+        /// @brief Get the time integration scheme
+        FirstOrderScheme scheme() const;
+
+        /// @brief Get the order of accuracy of the time integration scheme
+        int order() const override;
+
+        /// @brief Advance the solution by a single time step, without invoking the monitor
+        /// @param dt Time step
+        /// @return Number of linear solver iterations
+        int take_step(Scalar dt) override;
+
+        /// @brief Estimate the local truncation error of the last step
+        /// @note Requires order() + 1 solutions, i.e. not available for the first order() steps
+        bool estimate_error(la::petsc::PetscVec &err) const override;
+
+        /// @brief Store the current state, i.e. the time and the solution history
+        void save_state() override;
+
+        /// @brief Restore the state stored by the last call to save_state()
+        void restore_state() override;
+
+    protected:
+        /// @brief Time integration scheme
+        FirstOrderScheme scheme_;
+
+        /// @brief Solution at the current and two previous time steps
+        la::petsc::PetscVec u_;
+        la::petsc::PetscVec u_prev_;
+        la::petsc::PetscVec u_prev2_;
+
+        /// @brief Predicted solution for the last step
+        la::petsc::PetscVec u_pred_;
+
+        /// @brief Load vector at the next and current time steps
+        la::petsc::PetscVec F_;
+        la::petsc::PetscVec F_prev_;
+
+        /// @brief Work vectors
+        la::petsc::PetscVec rhs_;
+        la::petsc::PetscVec work_;
+
+        /// @brief Whether F_prev_ holds the load at the current time
+        bool has_prev_load_ = false;
+
+        /// @brief Previous two time steps
+        Scalar dt_prev_ = 0;
+        Scalar dt_prev2_ = 0;
+
+        /// @brief Factor c for the error estimate of the last step, i.e. err = c (u - u_pred)
+        /// (zero if no estimate is available)
+        Scalar error_factor_ = 0;
+
+        /// @brief State stored by save_state()
+        std::vector<la::petsc::PetscVec> saved_vecs_;
+        Scalar saved_dt_prev_ = 0;
+        Scalar saved_dt_prev2_ = 0;
+        bool saved_has_prev_load_ = false;
+    };
+}
+
+#endif // SFEM_HAS_PETSC
\ No newline at end of file
@@ -0,0 +1,151 @@
+#include "geometric_multigrid.h"
+#include "../fe/utils/assembly.h"
+#include "../fe/utils/grid_transfer.h"
+#include "../common/logger.h"
+#include "../common/error.h"
+
+namespace sfem::solvers
+{
+    //=============================================================================
+    GeometricMultigrid::GeometricMultigrid(const std::vector<std::vector<std::shared_ptr<fe::FiniteElement>>> &elems,
+                                           const std::vector<mesh::Field> &fields,
+                                           fe::FEMatrixType type,
+                                           Scalar time)
+        : elems_(elems),
+          fields_(fields),
+          type_(type)
+    {
+        if (fields_.size() < 2)
+        {
+            Logger::instance().error("Geometric multigrid requires at least two levels", __FILE__, __LINE__);
+        }
+        if (elems_.size() != fields_.size())
+        {
+            error::invalid_size_error(fields_.size(), elems_.size(), __FILE__, __LINE__);
+        }
+
+        for (std::size_t l = 1; l < fields_.size(); l++)
+        {
+            interps_.push_back(fe::create_interpolation(fields_[l - 1], fields_[l]));
+        }
+        for (std::size_t l = 0; l < fields_.size() - 1; l++)
+        {
+            operators_.push_back(la::petsc::create_mat(fields_[l].mesh(), fields_[l].n_vars()));
+        }
+        assemble_operators(time);
+    }
+    //=============================================================================
+    GeometricMultigrid::GeometricMultigrid(const std::vector<mesh::Field> &fields, const la::petsc::PetscMat &A)
+        : fields_(fields),
+          type_(fe::FEMatrixType::stiffness)
+    {
+        if (fields_.size() < 2)
+        {
+            Logger::instance().error("Geometric multigrid requires at least two levels", __FILE__, __LINE__);
+        }
+
+        for (std::size_t l = 1; l < fields_.size(); l++)
+        {
+            interps_.push_back(fe::create_interpolation(fields_[l - 1], fields_[l]));
+        }
+        project_operators(A);
+    }
+    //=============================================================================
+    int GeometricMultigrid::n_levels() const
+    {
+        return static_cast<int>(fields_.size());
+    }
+    //=============================================================================
+    const la::petsc::PetscMat &GeometricMultigrid::interpolation(int l) const
+    {
+        if (l < 1 || l >= n_levels())
+        {
+            Logger::instance().error("Invalid level " + std::to_string(l) + " for interpolation", __FILE__, __LINE__);
+        }
+        return interps_[l - 1];
+    }
+    //=============================================================================
+    const la::petsc::PetscMat &GeometricMultigrid::coarse_operator(int l) const
+    {
+        if (l < 0 || l >= n_levels() - 1)
+        {
+            Logger::instance().error("Invalid coarse level " + std::to_string(l), __FILE__, __LINE__);
+        }
+        return operators_[l];
+    }
+    //=============================================================================
+    void GeometricMultigrid::assemble_operators(Scalar time)
+    {
+        if (elems_.empty())
+        {
+            Logger::instance().error("Rediscretised coarse operators require the elements of each level", __FILE__, __LINE__);
+        }
+        for (std::size_t l = 0; l < operators_.size(); l++)
+        {
+            MatZeroEntries(operators_[l].mat());
+            fe::assemble_constrained_matrix(elems_[l], fields_[l], type_, operators_[l], time);
+        }
+    }
+    //=============================================================================
+    void GeometricMultigrid::project_operators(const la::petsc::PetscMat &A)
+    {
+        // From the finest level downwards
+        std::vector<la::petsc::PetscMat> operators;
+        for (int l = n_levels() - 1; l > 0; l--)
+        {
+            Mat A_coarse;
+            MatPtAP(l == n_levels() - 1 ? A.mat() : operators.back().mat(), interps_[l - 1].mat(),
+                    MAT_INITIAL_MATRIX, PETSC_DEFAULT, &A_coarse);
+
+            // Unit diagonal for the fixed DoF, whose interpolation columns are zero
+            const auto &field = fields_[l - 1];
+            auto im = field.dof_im();
+            int n_vars = field.n_vars();
+            auto [fixed_dof, fixed_values] = field.get_local_fixed_dof();
+            std::vector<int> fixed_rows;
+            for (auto dof : fixed_dof)
+            {
+                if (dof < field.n_dof_owned())
+                {
+                    fixed_rows.push_back(im.local_to_global(dof / n_vars) * n_vars + dof % n_vars);
+                }
+            }
+            MatZeroRowsColumns(A_coarse, fixed_rows.size(), fixed_rows.data(), 1.0, nullptr, nullptr);
+
+            operators.push_back(la::petsc::PetscMat(A_coarse, false));
+        }
+
+        operators_.clear();
+        for (auto it = operators.rbegin(); it != operators.rend(); ++it)
+        {
+            operators_.push_back(std::move(*it));
+        }
+    }
+    //=============================================================================
+    void GeometricMultigrid::set_rigid_body_modes()
+    {
+        la::petsc::set_rigid_body_modes(operators_[0], fields_[0]);
+    }
+    //=============================================================================
+    void GeometricMultigrid::setup(la::petsc::PetscKSP &ksp) const
+    {
+        PC pc;
+        KSPGetPC(ksp.ksp(), &pc);
+        PCSetType(pc, PCMG);
+        PCMGSetLevels(pc, n_levels(), nullptr);
+        PCMGSetGalerkin(pc, PC_MG_GALERKIN_NONE);
+
+        for (int l = 1; l < n_levels(); l++)
+        {
+            PCMGSetInterpolation(pc, l, interps_[l - 1].mat());
+        }
+
+        // The finest level operator is taken from the KSP
+        for (int l = 0; l < n_levels() - 1; l++)
+        {
+            KSP smoother;
+            PCMGGetSmoother(pc, l, &smoother);
+            KSPSetOperators(smoother, operators_[l].mat(), operators_[l].mat());
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,100 @@
+#pragma once
+
+#ifdef SFEM_HAS_PETSC
+
+#include "../fe/finite_element.h"
+#include "../la/petsc/petsc_utils.h"
+#include <memory>
+
+namespace sfem::solvers
+{
+    /// @brief Geometric multigrid preconditioner over a hierarchy of meshes of the same domain,
+    /// backed by PETSc's PCMG
+    /// @note The meshes need not be nested: the interpolation between consecutive levels is built by locating
+    /// the fine nodes in the coarse cells, see fe::create_interpolation. The restriction is its transpose
+    /// @note The levels may also share the same cells with decreasing polynomial orders (p-multigrid), e.g. a
+    /// quadratic mesh and its mesh::create_linear_mesh, or combine both kinds of coarsening
+    /// @note The coarse operators are either rediscretised, i.e. assembled from each level's own elements
+    /// (usually of the same types as on the finest level) with their fixed DoF eliminated as by
+    /// fe::assemble_constrained_matrix, or computed by Galerkin projection of the finest operator.
+    /// The finest operator is the one of the KSP
+    /// @note The smoothers and the coarse solver are configured from the options database,
+    /// e.g. -mg_levels_ksp_type chebyshev -mg_levels_pc_type jacobi -mg_coarse_pc_type lu, or
+    /// -mg_coarse_pc_type gamg for an algebraic multigrid on the (linear) coarsest level
+    class GeometricMultigrid
+    {
+    public:
+        /// @brief Create a GeometricMultigrid
+        /// @note The interpolation operators and the coarse operators are built on creation
+        /// @param elems The contributing elements of each level, ordered from coarsest to finest
+        /// @param fields The field of each level, ordered from coarsest to finest, with the same
+        /// number of variables and the same fixed DoF regions
+        /// @param type Element matrix type of the operators, e.g. stiffness
+        /// @param time Current solution time, passed to the elements
+        GeometricMultigrid(const std::vector<std::vector<std::shared_ptr<fe::FiniteElement>>> &elems,
+                           const std::vector<mesh::Field> &fields,
+                           fe::FEMatrixType type = fe::FEMatrixType::stiffness,
+                           Scalar time = 0);
+
+        /// @brief Create a GeometricMultigrid with Galerkin coarse operators
+        /// @note The interpolation operators and the coarse operators are built on creation
+        /// @param fields The field of each level, ordered from coarsest to finest, with the same
+        /// number of variables and the same fixed DoF regions
+        /// @param A The operator of the finest level
+        GeometricMultigrid(const std::vector<mesh::Field> &fields, const la::petsc::PetscMat &A);
+
+        // Copy constructor (deleted)
+        GeometricMultigrid(const GeometricMultigrid &) = delete;
+
+        // Copy assignment (deleted)
+        GeometricMultigrid &operator=(const GeometricMultigrid &) = delete;
+
+        /// @brief Get the number of levels
+        int n_levels() const;
+
+        /// @brief Get the interpolation operator from level l - 1 to level l (l > 0)
+        const la::petsc::PetscMat &interpolation(int l) const;
+
+        /// @brief Get the operator of level l (l < n_levels() - 1)
+        const la::petsc::PetscMat &coarse_operator(int l) const;
+
+        /// @brief Re-assemble the coarse operators, e.g. after the elements' properties have changed
+        /// @note Requires the elements of each level, i.e. rediscretised coarse operators
+        /// @param time Current solution time, passed to the elements
+        void assemble_operators(Scalar time = 0);
+
+        /// @brief Compute the coarse operators by Galerkin projection, i.e. A_(l-1) = P_l^T A_l P_l
+        /// @note The rows and columns of the fixed DoF are zero in the projected operators, thus they are
+        /// given a unit diagonal
+        /// @param A The operator of the finest level
+        void project_operators(const la::petsc::PetscMat &A);
+
+        /// @brief Set the rigid body modes of the coarsest level as the near null space of its operator,
+        /// e.g. for -mg_coarse_pc_type gamg on elasticity problems
+        /// @note See la::petsc::set_rigid_body_modes
+        void set_rigid_body_modes();
+
+        /// @brief Set the preconditioner of a KSP to this multigrid hierarchy
+        /// @note Call before set_from_options() on the KSP, so that the multigrid options are applied
+        /// @param ksp The KSP, whose operator is defined on the finest level
+        void setup(la::petsc::PetscKSP &ksp) const;
+
+    private:
+        /// @brief Contributing elements of each level
+        std::vector<std::vector<std::shared_ptr<fe::FiniteElement>>> elems_;
+
+        /// @brief Field of each level
+        std::vector<mesh::Field> fields_;
+
+        /// @brief Element matrix type of the operators
+        fe::FEMatrixType type_;
+
+        /// @brief Interpolation operators, from each level to the next one
+        std::vector<la::petsc::PetscMat> interps_;
+
+        /// @brief Operators of the coarse levels
+        std::vector<la::petsc::PetscMat> operators_;
+    };
+}
+
+#endif // SFEM_HAS_PETSC
\ No newline at end of file
@@ -0,0 +1,232 @@
+#include "newton_solver.h"
+#include "../fe/utils/assembly.h"
+#include "../common/logger.h"
+#include "../common/timer.h"
+
+namespace sfem::solvers
+{
+    //=============================================================================
+    NewtonSolver::NewtonSolver(const std::vector<std::shared_ptr<fe::FiniteElement>> &elems,
+                               mesh::Field &field,
+                               Scalar time)
+        : elems_(elems),
+          field_(field),
+          time_(time),
+          r_(la::petsc::create_vec(field.mesh(), field.n_vars())),
+          x_(r_.copy())
+    {
+        // The sparsity pattern is computed once, and kept for all Jacobian evaluations
+        auto [diag_nnz, off_diag_nnz] = la::sparsity_pattern(field_.mesh(), field_.n_vars());
+        J_ = std::make_unique<la::petsc::PetscMat>(diag_nnz, off_diag_nnz, field_.n_vars());
+
+        SNESCreate(SFEM_COMM_WORLD, &snes_);
+        SNESSetType(snes_, SNESNEWTONLS);
+        SNESSetFunction(snes_, r_.vec(), NewtonSolver::form_residual, this);
+        SNESSetJacobian(snes_, J_->mat(), J_->mat(), NewtonSolver::form_jacobian, this);
+
+        SNESLineSearch line_search;
+        SNESGetLineSearch(snes_, &line_search);
+        SNESLineSearchSetType(line_search, SNESLINESEARCHBT);
+        set_from_options();
+
+        update_fixed_dof();
+    }
+    //=============================================================================
+    NewtonSolver::~NewtonSolver()
+    {
+        if (snes_)
+        {
+            SNESDestroy(&snes_);
+        }
+    }
+    //=============================================================================
+    SNES NewtonSolver::snes() const
+    {
+        return snes_;
+    }
+    //=============================================================================
+    mesh::Field &NewtonSolver::field() const
+    {
+        return field_;
+    }
+    //=============================================================================
+    void NewtonSolver::set_time(Scalar time)
+    {
+        time_ = time;
+    }
+    //=============================================================================
+    Scalar NewtonSolver::time() const
+    {
+        return time_;
+    }
+    //=============================================================================
+    void NewtonSolver::set_options_prefix(const std::string &prefix) const
+    {
+        SNESSetOptionsPrefix(snes_, prefix.c_str());
+    }
+    //=============================================================================
+    void NewtonSolver::set_from_options() const
+    {
+        SNESSetFromOptions(snes_);
+    }
+    //=============================================================================
+    void NewtonSolver::set_tolerances(Scalar rtol, Scalar atol, Scalar stol, int max_iter) const
+    {
+        if (rtol < 0 || atol < 0 || stol < 0 || max_iter < 1)
+        {
+            Logger::instance().error("Invalid Newton solver tolerances", __FILE__, __LINE__);
+        }
+        SNESSetTolerances(snes_, atol, rtol, stol, max_iter, PETSC_DEFAULT);
+    }
+    //=============================================================================
+    void NewtonSolver::set_lag_jacobian(int lag, bool persists) const
+    {
+        if (lag == 0 || lag < -1)
+        {
+            Logger::instance().error("Invalid Jacobian lag " + std::to_string(lag), __FILE__, __LINE__);
+        }
+        SNESSetLagJacobian(snes_, lag);
+        SNESSetLagJacobianPersists(snes_, persists ? PETSC_TRUE : PETSC_FALSE);
+    }
+    //=============================================================================
+    void NewtonSolver::set_lag_preconditioner(int lag, bool persists) const
+    {
+        if (lag == 0 || lag < -1)
+        {
+            Logger::instance().error("Invalid preconditioner lag " + std::to_string(lag), __FILE__, __LINE__);
+        }
+        SNESSetLagPreconditioner(snes_, lag);
+        SNESSetLagPreconditionerPersists(snes_, persists ? PETSC_TRUE : PETSC_FALSE);
+    }
+    //=============================================================================
+    void NewtonSolver::set_eisenstat_walker(bool flag) const
+    {
+        SNESKSPSetUseEW(snes_, flag ? PETSC_TRUE : PETSC_FALSE);
+    }
+    //=============================================================================
+    void NewtonSolver::set_line_search(const std::string &type) const
+    {
+        SNESLineSearch line_search;
+        SNESGetLineSearch(snes_, &line_search);
+        SNESLineSearchSetType(line_search, type.c_str());
+    }
+    //=============================================================================
+    void NewtonSolver::update_fixed_dof()
+    {
+        // Keep only the owned fixed DoF
+        auto [local_dof, values] = field_.get_local_fixed_dof();
+        int n_vars = field_.n_vars();
+        const auto &dof_im = field_.dof_im();
+        fixed_dof_.clear();
+        fixed_dof_local_.clear();
+        fixed_dof_values_.clear();
+        for (std::size_t i = 0; i < local_dof.size(); i++)
+        {
+            if (local_dof[i] < field_.n_dof_owned())
+            {
+                int node = dof_im.local_to_global(local_dof[i] / n_vars);
+                fixed_dof_.push_back(node * n_vars + local_dof[i] % n_vars);
+                fixed_dof_local_.push_back(local_dof[i]);
+                fixed_dof_values_.push_back(values[i]);
+            }
+        }
+    }
+    //=============================================================================
+    int NewtonSolver::solve()
+    {
+        common::Timer timer("Newton solver");
+
+        // Initial guess, with the fixed values enforced
+        la::petsc::field_to_vec(field_, x_);
+        x_.insert_values(fixed_dof_, fixed_dof_values_);
+        x_.assemble();
+
+        SNESSolve(snes_, nullptr, x_.vec());
+        la::petsc::vec_to_field(x_, field_);
+
+        // Get the number of iterations the SNES performed
+        PetscInt n_iter;
+        SNESGetIterationNumber(snes_, &n_iter);
+
+        // Check for convergence
+        if (!converged())
+        {
+            SNESConvergedReason reason;
+            SNESGetConvergedReason(snes_, &reason);
+            std::string message = "NewtonSolver did not converge in " + std::to_string(n_iter) + " iterations\n";
+            message += "Reason: " + std::to_string(reason) + "\n";
+            Logger::instance().warn(message, __FILE__, __LINE__);
+        }
+
+        return static_cast<int>(n_iter);
+    }
+    //=============================================================================
+    bool NewtonSolver::converged() const
+    {
+        SNESConvergedReason reason;
+        SNESGetConvergedReason(snes_, &reason);
+        return reason > 0;
+    }
+    //=============================================================================
+    int NewtonSolver::n_jacobian_evaluations() const
+    {
+        return n_jacobian_evaluations_;
+    }
+    //=============================================================================
+    int NewtonSolver::n_residual_evaluations() const
+    {
+        return n_residual_evaluations_;
+    }
+    //=============================================================================
+    PetscErrorCode NewtonSolver::form_residual(SNES snes, Vec x, Vec f, void *ctx)
+    {
+        auto solver = static_cast<NewtonSolver *>(ctx);
+        solver->update_field(x);
+
+        // Free DoF: element residuals
+        la::petsc::PetscVec F(f, true);
+        F.set_all(0.0);
+        fe::assemble_constrained_vector(solver->elems_, solver->field_, fe::FEVectorType::residual, F, solver->time_);
+
+        // Fixed DoF: u - g
+        std::vector<Scalar> values(solver->fixed_dof_.size());
+        const Scalar *x_values;
+        VecGetArrayRead(x, &x_values);
+        for (std::size_t i = 0; i < values.size(); i++)
+        {
+            values[i] = x_values[solver->fixed_dof_local_[i]] - solver->fixed_dof_values_[i];
+        }
+        VecRestoreArrayRead(x, &x_values);
+        F.insert_values(solver->fixed_dof_, values);
+        F.assemble();
+
+        solver->n_residual_evaluations_++;
+        return 0;
+    }
+    //=============================================================================
+    PetscErrorCode NewtonSolver::form_jacobian(SNES snes, Vec x, Mat J, Mat P, void *ctx)
+    {
+        auto solver = static_cast<NewtonSolver *>(ctx);
+        solver->update_field(x);
+
+        // The rows and columns of the fixed DoF are replaced by the identity
+        la::petsc::PetscMat Pmat(P, true);
+        MatZeroEntries(P);
+        fe::assemble_constrained_matrix(solver->elems_, solver->field_, fe::FEMatrixType::jacobian, Pmat, solver->time_);
+
+        // E.g. matrix-free operator, distinct from the preconditioning matrix
+        if (J != P)
+        {
+            MatAssemblyBegin(J, MAT_FINAL_ASSEMBLY);
+            MatAssemblyEnd(J, MAT_FINAL_ASSEMBLY);
+        }
+
+        solver->n_jacobian_evaluations_++;
+        return 0;
+    }
+    //=============================================================================
+    void NewtonSolver::update_field(Vec x)
+    {
+        la::petsc::vec_to_field(la::petsc::PetscVec(x, true), field_);
+    }
+}
\ No newline at end of file
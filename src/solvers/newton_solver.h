@@ -0,0 +1,143 @@
+#pragma once
+
+#ifdef SFEM_HAS_PETSC
+
+#include "../fe/finite_element.h"
+#include "../la/petsc/petsc_utils.h"
+#include <petscsnes.h>
+#include <memory>
+
+namespace sfem::solvers
+{
+    /// @brief Newton solver for nonlinear systems of the form R(u) = 0, backed by PETSc's SNES
+    /// @note The residual and Jacobian are assembled from the elements' FEVectorType::residual and
+    /// FEMatrixType::jacobian contributions, evaluated at the current iterate
+    /// @note The fixed DoF are eliminated from the Jacobian, whose corresponding rows are set to the
+    /// identity, while the corresponding residual entries are u - g. The fixed values are enforced on
+    /// the initial guess, thus they are never updated by the Newton steps
+    /// @note The Jacobian and preconditioner may be lagged, i.e. only rebuilt every few Newton steps,
+    /// and optionally across solves, see set_lag_jacobian() and set_lag_preconditioner()
+    class NewtonSolver
+    {
+    public:
+        /// @brief Create a NewtonSolver
+        /// @note By default, a Newton method with a backtracking line search is used. Both can be
+        /// changed from the options database, see set_from_options()
+        /// @param elems The contributing elements
+        /// @param field The solution field. Its current values are used as initial guess
+        /// @param time Solution time, passed to the elements
+        NewtonSolver(const std::vector<std::shared_ptr<fe::FiniteElement>> &elems,
+                     mesh::Field &field,
+                     Scalar time = 0);
+
+        // Copy constructor (deleted)
+        NewtonSolver(const NewtonSolver &) = delete;
+
+        // Copy assignment (deleted)
+        NewtonSolver &operator=(const NewtonSolver &) = delete;
+
+        /// @brief Destructor
+        ~NewtonSolver();
+
+        /// @brief Get the underlying PETSc SNES
+        SNES snes() const;
+
+        /// @brief Get the solution field
+        mesh::Field &field() const;
+
+        /// @brief Set the solution time, passed to the elements
+        void set_time(Scalar time);
+
+        /// @brief Get the solution time
+        Scalar time() const;
+
+        /// @brief Set the options prefix of the SNES (and of its KSP)
+        void set_options_prefix(const std::string &prefix) const;
+
+        /// @brief Set the solver options from the PETSc options database
+        void set_from_options() const;
+
+        /// @brief Set the convergence tolerances
+        /// @param rtol Relative tolerance on the residual norm
+        /// @param atol Absolute tolerance on the residual norm
+        /// @param stol Tolerance on the Newton step norm, relative to the solution norm
+        /// @param max_iter Maximum number of Newton iterations
+        void set_tolerances(Scalar rtol, Scalar atol, Scalar stol, int max_iter) const;
+
+        /// @brief Set how often the Jacobian is rebuilt
+        /// @param lag -1: never rebuild, 1: rebuild every Newton step, n: rebuild every n steps
+        /// @param persists Whether the lag persists across solves, i.e. the Jacobian from
+        /// a previous solve may be reused
+        void set_lag_jacobian(int lag, bool persists = false) const;
+
+        /// @brief Set how often the preconditioner is rebuilt
+        /// @note See set_lag_jacobian()
+        void set_lag_preconditioner(int lag, bool persists = false) const;
+
+        /// @brief Whether to use Eisenstat-Walker inexact tolerances for the linear solves,
+        /// i.e. the linear tolerance is adapted to the progress of the Newton iteration
+        void set_eisenstat_walker(bool flag) const;
+
+        /// @brief Set the line search type, e.g. "bt" (backtracking), "basic" (full Newton step),
+        /// "l2" or "cp"
+        void set_line_search(const std::string &type) const;
+
+        /// @brief Re-read the fixed DoF of the field
+        /// @note Call after the field's fixed DoF have been modified
+        void update_fixed_dof();
+
+        /// @brief Solve the nonlinear system, using the current field values as initial guess
+        /// @note The field values are updated with the solution
+        /// @return Number of Newton iterations
+        int solve();
+
+        /// @brief Whether the last solve converged
+        bool converged() const;
+
+        /// @brief Get the number of Jacobian evaluations since creation
+        int n_jacobian_evaluations() const;
+
+        /// @brief Get the number of residual evaluations since creation
+        int n_residual_evaluations() const;
+
+    private:
+        /// @brief Residual evaluation callback
+        static PetscErrorCode form_residual(SNES snes, Vec x, Vec f, void *ctx);
+
+        /// @brief Jacobian evaluation callback
+        static PetscErrorCode form_jacobian(SNES snes, Vec x, Mat J, Mat P, void *ctx);
+
+        /// @brief Copy an iterate to the field values, including the ghosts
+        void update_field(Vec x);
+
+        /// @brief Contributing elements
+        std::vector<std::shared_ptr<fe::FiniteElement>> elems_;
+
+        /// @brief Solution field
+        mesh::Field &field_;
+
+        /// @brief Solution time
+        Scalar time_;
+
+        /// @brief PETSc SNES
+        SNES snes_ = nullptr;
+
+        /// @brief Jacobian, whose sparsity pattern is kept across evaluations
+        std::unique_ptr<la::petsc::PetscMat> J_;
+
+        /// @brief Residual and solution vectors
+        la::petsc::PetscVec r_;
+        la::petsc::PetscVec x_;
+
+        /// @brief Owned fixed DoF, in global and local indexing, and their values
+        std::vector<int> fixed_dof_;
+        std::vector<int> fixed_dof_local_;
+        std::vector<Scalar> fixed_dof_values_;
+
+        /// @brief Evaluation counters
+        int n_jacobian_evaluations_ = 0;
+        int n_residual_evaluations_ = 0;
+    };
+}
+
+#endif // SFEM_HAS_PETSC
\ No newline at end of file
@@ -0,0 +1,123 @@
+#include "runge_kutta_integrator.h"
+#include "../common/logger.h"
+
+namespace sfem::solvers
+{
+    //=============================================================================
+    RungeKuttaIntegrator::RungeKuttaIntegrator(const std::vector<std::shared_ptr<fe::FiniteElement>> &elems,
+                                               mesh::Field &field,
+                                               RungeKuttaScheme scheme,
+                                               fe::MatrixLumping lumping,
+                                               Scalar time)
+        : ExplicitIntegrator(elems, field, lumping, time),
+          scheme_(scheme)
+    {
+        switch (scheme_)
+        {
+        case RungeKuttaScheme::forward_euler:
+            a_ = {0};
+            b_ = {1};
+            c_ = {0};
+            stability_limit_ = 2.0;
+            break;
+        case RungeKuttaScheme::heun:
+            a_ = {0, 0,
+                  1, 0};
+            b_ = {0.5, 0.5};
+            c_ = {0, 1};
+            stability_limit_ = 2.0;
+            break;
+        case RungeKuttaScheme::ssp_rk3:
+            a_ = {0, 0, 0,
+                  1, 0, 0,
+                  0.25, 0.25, 0};
+            b_ = {1.0 / 6, 1.0 / 6, 2.0 / 3};
+            c_ = {0, 1, 0.5};
+            stability_limit_ = 2.51;
+            break;
+        case RungeKuttaScheme::rk4:
+            a_ = {0, 0, 0, 0,
+                  0.5, 0, 0, 0,
+                  0, 0.5, 0, 0,
+                  0, 0, 1, 0};
+            b_ = {1.0 / 6, 1.0 / 3, 1.0 / 3, 1.0 / 6};
+            c_ = {0, 0.5, 0.5, 1};
+            stability_limit_ = 2.78;
+            break;
+        default:
+            Logger::instance().error("Unknown Runge-Kutta scheme", __FILE__, __LINE__);
+        }
+
+        k_.resize(n_stages());
+    }
+    //=============================================================================
+    RungeKuttaScheme RungeKuttaIntegrator::scheme() const
+    {
+        return scheme_;
+    }
+    //=============================================================================
+    int RungeKuttaIntegrator::n_stages() const
+    {
+        return static_cast<int>(b_.size());
+    }
+    //=============================================================================
+    int RungeKuttaIntegrator::order() const
+    {
+        // Equal to the number of stages, for all supported schemes
+        return n_stages();
+    }
+    //=============================================================================
+    Scalar RungeKuttaIntegrator::stable_dt() const
+    {
+        return stability_limit_ / max_eigenvalue();
+    }
+    //=============================================================================
+    void RungeKuttaIntegrator::take_step(Scalar dt)
+    {
+        if (dt <= 0)
+        {
+            Logger::instance().error("Time step must be positive, got " + std::to_string(dt), __FILE__, __LINE__);
+        }
+
+        int n_owned = field_.n_dof_owned();
+        int s = n_stages();
+        u0_ = field_.values();
+        u_ = u0_;
+
+        for (int i = 0; i < s; i++)
+        {
+            // Stage solution
+            for (int j = 0; j < i; j++)
+            {
+                if (a_[i * s + j] == 0)
+                {
+                    continue;
+                }
+                for (int l = 0; l < n_owned; l++)
+                {
+                    u_[l] += dt * a_[i * s + j] * k_[j][l];
+                }
+            }
+
+            // Stage rate, i.e. M^-1 (F - R)
+            compute_forces(time_ + c_[i] * dt, u_, k_[i]);
+            for (int l = 0; l < n_owned; l++)
+            {
+                k_[i][l] /= mass_[l];
+            }
+
+            // Next stage starts from the solution at the beginning of the step
+            std::copy(u0_.cbegin(), u0_.cbegin() + n_owned, u_.begin());
+        }
+
+        for (int i = 0; i < s; i++)
+        {
+            for (int l = 0; l < n_owned; l++)
+            {
+                u_[l] += dt * b_[i] * k_[i][l];
+            }
+        }
+
+        complete_step(dt, u_);
+    }
+}
\ No newline at end of file
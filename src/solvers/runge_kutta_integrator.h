@@ -0,0 +1,71 @@
+#pragma once
+
+#include "explicit_integrator.h"
+
+namespace sfem::solvers
+{
+    /// @brief Explicit Runge-Kutta schemes
+    enum class RungeKuttaScheme
+    {
+        forward_euler = 0,
+        heun = 1,
+        ssp_rk3 = 2,
+        rk4 = 3
+    };
+
+    /// @brief Explicit Runge-Kutta integrator for first order systems of the form M u' + R(u, t) = F(t),
+    /// e.g. fast thermal transients
+    /// @note Each stage requires a single internal force evaluation, and a division by the lumped mass
+    /// @note Stable for dt <= r / lambda_max, where lambda_max is the largest eigenvalue of M^-1 K and r is
+    /// the extent of the scheme's stability region along the negative real axis (2 for forward Euler and Heun,
+    /// 2.51 for SSP-RK3 and 2.78 for RK4)
+    class RungeKuttaIntegrator : public ExplicitIntegrator
+    {
+    public:
+        /// @brief Create a RungeKuttaIntegrator
+        /// @param elems The contributing elements
+        /// @param field The solution field. Its current values are used as initial condition
+        /// @param scheme Runge-Kutta scheme
+        /// @param lumping Mass lumping method
+        /// @param time Initial time
+        RungeKuttaIntegrator(const std::vector<std::shared_ptr<fe::FiniteElement>> &elems,
+                             mesh::Field &field,
+                             RungeKuttaScheme scheme = RungeKuttaScheme::ssp_rk3,
+                             fe::MatrixLumping lumping = fe::MatrixLumping::diagonal_scaling,
+                             Scalar time = 0);
+
+        /// @brief Get the Runge-Kutta scheme
+        RungeKuttaScheme scheme() const;
+
+        /// @brief Get the number of stages, i.e. of internal force evaluations per step
+        int n_stages() const;
+
+        /// @brief Get the order of accuracy of the time integration scheme
+        int order() const override;
+
+        /// @brief Estimate the critical time step, i.e. r / lambda_max
+        Scalar stable_dt() const override;
+
+        /// @brief Advance the solution by a single time step, without invoking the monitor
+        /// @param dt Time step
+        void take_step(Scalar dt) override;
+
+    private:
+        /// @brief Runge-Kutta scheme
+        RungeKuttaScheme scheme_;
+
+        /// @brief Butcher tableau, i.e. stage coefficients (lower triangular, row-wise),
+        /// weights and stage times
+        std::vector<Scalar> a_;
+        std::vector<Scalar> b_;
+        std::vector<Scalar> c_;
+
+        /// @brief Stability limit along the negative real axis
+        Scalar stability_limit_;
+
+        /// @brief Solution at the start of the step, stage solution and stage rates (local DoF)
+        std::vector<Scalar> u0_;
+        std::vector<Scalar> u_;
+        std::vector<std::vector<Scalar>> k_;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,250 @@
+#include "second_order_integrator.h"
+#include "../common/timer.h"
+#include "../common/logger.h"
+#include "../common/error.h"
+
+namespace sfem::solvers
+{
+    //=============================================================================
+    SecondOrderIntegrator::SecondOrderIntegrator(const std::vector<std::shared_ptr<fe::FiniteElement>> &elems,
+                                                 mesh::Field &field,
+                                                 SecondOrderScheme scheme,
+                                                 Scalar time)
+        : TimeIntegrator(elems, field, time),
+          scheme_(scheme),
+          beta_(0.25),
+          gamma_(0.5),
+          u_(la::petsc::create_vec(field.mesh(), field.n_vars())),
+          v_(u_.copy()),
+          a_(u_.copy()),
+          u_prev_(u_.copy()),
+          a_prev_(u_.copy()),
+          F_(u_.copy()),
+          F_prev_(u_.copy()),
+          rhs_(u_.copy()),
+          work_(u_.copy())
+    {
+        C_ = std::make_unique<la::petsc::PetscMat>(assemble_matrix(fe::FEMatrixType::damping));
+
+        if (scheme_ == SecondOrderScheme::generalized_alpha)
+        {
+            set_spectral_radius(0.8);
+        }
+
+        la::petsc::field_to_vec(field_, u_);
+    }
+    //=============================================================================
+    SecondOrderScheme SecondOrderIntegrator::scheme() const
+    {
+        return scheme_;
+    }
+    //=============================================================================
+    void SecondOrderIntegrator::set_newmark_parameters(Scalar beta, Scalar gamma)
+    {
+        if (beta <= 0 || gamma <= 0)
+        {
+            Logger::instance().error("Newmark parameters must be positive", __FILE__, __LINE__);
+        }
+        beta_ = beta;
+        gamma_ = gamma;
+        operator_valid_ = false;
+    }
+    //=============================================================================
+    void SecondOrderIntegrator::set_spectral_radius(Scalar rho_inf)
+    {
+        if (rho_inf < 0 || rho_inf > 1)
+        {
+            Logger::instance().error("Spectral radius must be in [0, 1], got " + std::to_string(rho_inf), __FILE__, __LINE__);
+        }
+        if (scheme_ != SecondOrderScheme::generalized_alpha)
+        {
+            Logger::instance().warn("Spectral radius only applies to the generalized-alpha method", __FILE__, __LINE__);
+            return;
+        }
+
+        // Chung & Hulbert: second order accurate, with maximal high frequency dissipation
+        alpha_m_ = (2 * rho_inf - 1) / (rho_inf + 1);
+        alpha_f_ = rho_inf / (rho_inf + 1);
+        gamma_ = 0.5 - alpha_m_ + alpha_f_;
+        beta_ = 0.25 * (1 - alpha_m_ + alpha_f_) * (1 - alpha_m_ + alpha_f_);
+        operator_valid_ = false;
+    }
+    //=============================================================================
+    void SecondOrderIntegrator::add_rayleigh_damping(Scalar a, Scalar b)
+    {
+        MatAXPY(C_->mat(), a, M_->mat(), DIFFERENT_NONZERO_PATTERN);
+        MatAXPY(C_->mat(), b, K_->mat(), DIFFERENT_NONZERO_PATTERN);
+
+        // The non-zero pattern of C may have changed
+        A_.reset();
+        operator_valid_ = false;
+    }
+    //=============================================================================
+    void SecondOrderIntegrator::set_initial_velocity(const std::vector<Scalar> &values)
+    {
+        if (static_cast<int>(values.size()) != v_.size_local())
+        {
+            error::invalid_size_error(v_.size_local(), values.size(), __FILE__, __LINE__);
+        }
+        Scalar *v_values;
+        VecGetArray(v_.vec(), &v_values);
+        std::copy(values.cbegin(), values.cend(), v_values);
+        VecRestoreArray(v_.vec(), &v_values);
+        initialized_ = false;
+    }
+    //=============================================================================
+    const la::petsc::PetscVec &SecondOrderIntegrator::velocity() const
+    {
+        return v_;
+    }
+    //=============================================================================
+    const la::petsc::PetscVec &SecondOrderIntegrator::acceleration() const
+    {
+        return a_;
+    }
+    //=============================================================================
+    void SecondOrderIntegrator::compute_initial_acceleration()
+    {
+        // RHS: F_0 - C v_0 - K u_0
+        la::petsc::vec_copy(F_prev_, rhs_);
+        la::petsc::mat_mult(*C_, v_, work_);
+        la::petsc::vec_axpy(-1.0, work_, rhs_);
+        la::petsc::mat_mult(*K_, u_, work_);
+        la::petsc::vec_axpy(-1.0, work_, rhs_);
+
+        // The acceleration of the fixed DoF is zero
+        std::vector<Scalar> zeros(fixed_dof_.size(), 0.0);
+        rhs_.insert_values(fixed_dof_, zeros);
+        rhs_.assemble();
+        auto M = la::petsc::mat_copy(*M_);
+        MatZeroRowsColumns(M.mat(), fixed_dof_.size(), fixed_dof_.data(), 1.0, nullptr, nullptr);
+
+        la::petsc::PetscKSP ksp;
+        ksp.set_options_prefix("init_");
+        ksp.set_from_options();
+        ksp.set_operator(M.mat());
+        a_.set_all(0.0);
+        ksp.solve(rhs_.vec(), a_.vec());
+    }
+    //=============================================================================
+    int SecondOrderIntegrator::order() const
+    {
+        return 2;
+    }
+    //=============================================================================
+    int SecondOrderIntegrator::take_step(Scalar dt)
+    {
+        common::Timer timer("Time step");
+
+        if (!initialized_)
+        {
+            compute_load(time_, F_prev_);
+            compute_initial_acceleration();
+            initialized_ = true;
+        }
+
+        compute_load(time_ + dt, F_);
+
+        // Newmark coefficients
+        Scalar a0 = 1 / (beta_ * dt * dt);
+        Scalar a1 = gamma_ / (beta_ * dt);
+        Scalar a2 = 1 / (beta_ * dt);
+        Scalar a3 = 1 / (2 * beta_) - 1;
+        Scalar a4 = gamma_ / beta_ - 1;
+        Scalar a5 = dt * (gamma_ / (2 * beta_) - 1);
+
+        // Effective operator: (1-am) a0 M + (1-af) a1 C + (1-af) K
+        update_operator((1 - alpha_m_) * a0, (1 - alpha_f_) * a1, 1 - alpha_f_);
+
+        // Effective load: (1-af) F_{n+1} + af F_n - af K u_n
+        //                 + M ((1-am)(a0 u_n + a2 v_n + a3 a_n) - am a_n)
+        //                 + C ((1-af)(a1 u_n + a4 v_n + a5 a_n) - af v_n)
+        la::petsc::vec_copy(F_, rhs_);
+        la::petsc::vec_axpby(alpha_f_, F_prev_, 1 - alpha_f_, rhs_);
+        if (alpha_f_ != 0)
+        {
+            la::petsc::mat_mult(*K_, u_, work_);
+            la::petsc::vec_axpy(-alpha_f_, work_, rhs_);
+        }
+
+        la::petsc::vec_copy(u_, work_);
+        la::petsc::vec_scale((1 - alpha_m_) * a0, work_);
+        la::petsc::vec_axpy((1 - alpha_m_) * a2, v_, work_);
+        la::petsc::vec_axpy((1 - alpha_m_) * a3 - alpha_m_, a_, work_);
+        la::petsc::mat_mult_add(*M_, work_, rhs_, rhs_);
+
+        la::petsc::vec_copy(u_, work_);
+        la::petsc::vec_scale((1 - alpha_f_) * a1, work_);
+        la::petsc::vec_axpy((1 - alpha_f_) * a4 - alpha_f_, v_, work_);
+        la::petsc::vec_axpy((1 - alpha_f_) * a5, a_, work_);
+        la::petsc::mat_mult_add(*C_, work_, rhs_, rhs_);
+
+        // Solve for the new displacement, using the current one as initial guess
+        la::petsc::vec_copy(u_, u_prev_);
+        int n_iter = solve_step(rhs_, u_);
+
+        // Update the acceleration and velocity:
+        // a_{n+1} = a0 (u_{n+1} - u_n) - a2 v_n - a3 a_n
+        // v_{n+1} = v_n + dt ((1-gamma) a_n + gamma a_{n+1})
+        la::petsc::vec_copy(u_, work_);
+        la::petsc::vec_axpby(-a0, u_prev_, a0, work_);
+        la::petsc::vec_axpy(-a2, v_, work_);
+        la::petsc::vec_axpy(-a3, a_, work_);
+        la::petsc::vec_axpy(dt * (1 - gamma_), a_, v_);
+        la::petsc::vec_axpy(dt * gamma_, work_, v_);
+        std::swap(a_, a_prev_);
+        la::petsc::vec_copy(work_, a_);
+
+        std::swap(F_, F_prev_);
+        dt_prev_ = dt;
+        complete_step(dt, u_);
+
+        return n_iter;
+    }
+    //=============================================================================
+    bool SecondOrderIntegrator::estimate_error(la::petsc::PetscVec &err) const
+    {
+        if (dt_prev_ == 0)
+        {
+            return false;
+        }
+        Scalar c = dt_prev_ * dt_prev_ * (beta_ - 1.0 / 6.0);
+        la::petsc::vec_copy(a_, err);
+        la::petsc::vec_axpby(-c, a_prev_, c, err);
+        return true;
+    }
+    //=============================================================================
+    void SecondOrderIntegrator::save_state()
+    {
+        TimeIntegrator::save_state();
+        if (saved_vecs_.empty())
+        {
+            for (int i = 0; i < 4; i++)
+            {
+                saved_vecs_.push_back(u_.copy());
+            }
+        }
+        la::petsc::vec_copy(u_, saved_vecs_[0]);
+        la::petsc::vec_copy(v_, saved_vecs_[1]);
+        la::petsc::vec_copy(a_, saved_vecs_[2]);
+        la::petsc::vec_copy(F_prev_, saved_vecs_[3]);
+        saved_initialized_ = initialized_;
+        saved_dt_prev_ = dt_prev_;
+    }
+    //=============================================================================
+    void SecondOrderIntegrator::restore_state()
+    {
+        if (saved_vecs_.empty())
+        {
+            Logger::instance().error("No state has been saved", __FILE__, __LINE__);
+        }
+        TimeIntegrator::restore_state();
+        la::petsc::vec_copy(saved_vecs_[0], u_);
+        la::petsc::vec_copy(saved_vecs_[1], v_);
+        la::petsc::vec_copy(saved_vecs_[2], a_);
+        la::petsc::vec_copy(saved_vecs_[3], F_prev_);
+        initialized_ = saved_initialized_;
+        dt_prev_ = saved_dt_prev_;
+        la::petsc::vec_to_field(u_, field_);
+    }
+}
\ No newline at end of file
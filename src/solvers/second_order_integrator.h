@@ -0,0 +1,122 @@
+#pragma once
+
+#ifdef SFEM_HAS_PETSC
+
+#include "time_integrator.h"
+
+namespace sfem::solvers
+{
+    /// @brief Time integration schemes for second order systems
+    enum class SecondOrderScheme
+    {
+        newmark = 0,
+        generalized_alpha = 1
+    };
+
+    /// @brief Implicit time integrator for second order systems of the form M u'' + C u' + K u = F(t),
+    /// e.g. structural dynamics
+    /// @note By default, Newmark uses the average acceleration method (beta = 1/4, gamma = 1/2),
+    /// while the generalized-alpha method (Chung & Hulbert) uses a spectral radius of 0.8
+    /// @note The initial acceleration is computed from the equation of motion at the initial time
+    /// @note The local truncation error is estimated from the change in acceleration (Zienkiewicz & Xie)
+    class SecondOrderIntegrator : public TimeIntegrator
+    {
+    public:
+        /// @brief Create a SecondOrderIntegrator
+        /// @param elems The contributing elements
+        /// @param field The solution (displacement) field. Its current values are used as initial condition
+        /// @param scheme Time integration scheme
+        /// @param time Initial time
+        SecondOrderIntegrator(const std::vector<std::shared_ptr<fe::FiniteElement>> &elems,
+                              mesh::Field &field,
+                              SecondOrderScheme scheme = SecondOrderScheme::newmark,
+                              Scalar time = 0);
+
+        /// @brief Get the time integration scheme
+        SecondOrderScheme scheme() const;
+
+        /// @brief Set the Newmark parameters
+        /// @note For the generalized-alpha method, alpha_m and alpha_f are left unchanged
+        void set_newmark_parameters(Scalar beta, Scalar gamma);
+
+        /// @brief Set the generalized-alpha parameters from the spectral radius at infinite frequency
+        /// @param rho_inf Spectral radius, in [0, 1]
+        void set_spectral_radius(Scalar rho_inf);
+
+        /// @brief Add Rayleigh damping to the damping matrix, i.e. C += a M + b K
+        void add_rayleigh_damping(Scalar a, Scalar b);
+
+        /// @brief Set the initial velocity
+        /// @param values Owned velocity values, laid out as the Field values
+        void set_initial_velocity(const std::vector<Scalar> &values);
+
+        /// @brief Get the current velocity
+        const la::petsc::PetscVec &velocity() const;
+
+        /// @brief Get the current acceleration
+        const la::petsc::PetscVec &acceleration() const;
+
+        /// @brief Get the order of accuracy of the time integration scheme
+        int order() const override;
+
+        /// @brief Advance the solution by a single time step, without invoking the monitor
+        /// @param dt Time step
+        /// @return Number of linear solver iterations
+        int take_step(Scalar dt) override;
+
+        /// @brief Estimate the local truncation error of the last step,
+        /// i.e. dt^2 (beta - 1/6) (a_{n+1} - a_n)
+        bool estimate_error(la::petsc::PetscVec &err) const override;
+
+        /// @brief Store the current state, i.e. the time, displacement, velocity and acceleration
+        void save_state() override;
+
+        /// @brief Restore the state stored by the last call to save_state()
+        void restore_state() override;
+
+    protected:
+        /// @brief Solve M a_0 = F_0 - C v_0 - K u_0 for the initial acceleration
+        void compute_initial_acceleration();
+
+        /// @brief Time integration scheme
+        SecondOrderScheme scheme_;
+
+        /// @brief Newmark parameters
+        Scalar beta_;
+        Scalar gamma_;
+
+        /// @brief Generalized-alpha parameters (zero for Newmark)
+        Scalar alpha_m_ = 0;
+        Scalar alpha_f_ = 0;
+
+        /// @brief Displacement, velocity and acceleration
+        la::petsc::PetscVec u_;
+        la::petsc::PetscVec v_;
+        la::petsc::PetscVec a_;
+
+        /// @brief Displacement and acceleration at the previous time step
+        la::petsc::PetscVec u_prev_;
+        la::petsc::PetscVec a_prev_;
+
+        /// @brief Load vector at the next and current time steps
+        la::petsc::PetscVec F_;
+        la::petsc::PetscVec F_prev_;
+
+        /// @brief Work vectors
+        la::petsc::PetscVec rhs_;
+        la::petsc::PetscVec work_;
+
+        /// @brief Whether the initial acceleration and load have been computed
+        bool initialized_ = false;
+
+        /// @brief Last time step (zero if no step has been taken)
+        Scalar dt_prev_ = 0;
+
+        /// @brief State stored by save_state()
+        std::vector<la::petsc::PetscVec> saved_vecs_;
+        bool saved_initialized_ = false;
+        Scalar saved_dt_prev_ = 0;
+    };
+}
+
+#endif // SFEM_HAS_PETSC
\ No newline at end of file
@@ -0,0 +1,18 @@
+#pragma once
+
+/// @brief Solvers for time dependent and nonlinear problems
+namespace sfem::solvers
+{
+
+}
+
+#include "time_integrator.h"
+#include "first_order_integrator.h"
+#include "second_order_integrator.h"
+#include "adaptive_time_stepper.h"
+#include "newton_solver.h"
+#include "explicit_integrator.h"
+#include "central_difference_integrator.h"
+#include "runge_kutta_integrator.h"
+#include "geometric_multigrid.h"
+#include "static_condensation.h"
\ No newline at end of file
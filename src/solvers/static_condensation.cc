@@ -0,0 +1,388 @@
+#include "static_condensation.h"
+#include "../fe/utils/assembly.h"
+#include "../common/logger.h"
+#include "../common/timer.h"
+#include "../common/math.h"
+
+namespace sfem::solvers
+{
+    namespace
+    {
+        /// @brief Get the number of nodes on the boundary of a cell, which precede the interior nodes
+        int n_boundary_nodes(mesh::CellType type, int order)
+        {
+            int n_nodes = mesh::cell_nodes(type, order);
+            switch (type)
+            {
+            case mesh::CellType::line:
+                return 2;
+            case mesh::CellType::triangle:
+                return 3 * order;
+            case mesh::CellType::quad:
+                return 4 * order;
+            case mesh::CellType::tet:
+                return n_nodes - (order - 1) * (order - 2) * (order - 3) / 6;
+            case mesh::CellType::hex:
+                return n_nodes - (order - 1) * (order - 1) * (order - 1);
+            default:
+                return n_nodes;
+            }
+        }
+    }
+    //=============================================================================
+    StaticCondensation::StaticCondensation(const std::vector<std::shared_ptr<fe::FiniteElement>> &elems,
+                                           const mesh::Field &field)
+        : elems_(elems),
+          field_(field),
+          skeleton_im_(0),
+          skeleton_dof_im_(0)
+    {
+        const auto &mesh = field_.mesh();
+        const auto &cells = mesh.cells();
+        const auto &conn = mesh.cell_node_conn();
+        const auto &node_im = mesh.node_im();
+        int n_nodes_owned = node_im.n_owned();
+        int n_nodes_local = node_im.n_local();
+
+        // The interior nodes belong to a single cell of the mesh's dimension, i.e. to the cell's owner
+        std::vector<bool> is_interior(n_nodes_local, false);
+        for (std::size_t c = 0; c < cells.size(); c++)
+        {
+            if (cells[c].dim() != mesh.dim())
+            {
+                continue;
+            }
+            for (int i = n_boundary_nodes(cells[c].type(), cells[c].order()); i < conn.cnt[c]; i++)
+            {
+                is_interior[conn.idx[conn.ptr[c] + i]] = true;
+            }
+        }
+
+        // Skeleton nodes, keeping their global index and owner
+        std::vector<int> owned_idxs, ghost_idxs, ghost_owners;
+        auto node_ghost_owners = node_im.get_ghost_owners();
+        skeleton_nodes_.assign(n_nodes_local, -1);
+        for (int i = 0; i < n_nodes_local; i++)
+        {
+            if (is_interior[i])
+            {
+                continue;
+            }
+            skeleton_nodes_[i] = static_cast<int>(owned_idxs.size() + ghost_idxs.size());
+            if (i < n_nodes_owned)
+            {
+                owned_idxs.push_back(node_im.local_to_global(i));
+            }
+            else
+            {
+                ghost_idxs.push_back(node_im.local_to_global(i));
+                ghost_owners.push_back(node_ghost_owners[i - n_nodes_owned]);
+            }
+        }
+        skeleton_im_ = common::IndexMap(owned_idxs, ghost_idxs, ghost_owners);
+        skeleton_dof_im_ = skeleton_im_.renumber();
+
+        // Cell-to-skeleton node connectivity
+        for (std::size_t c = 0; c < cells.size(); c++)
+        {
+            skeleton_conn_.ptr.push_back(static_cast<int>(skeleton_conn_.idx.size()));
+            for (int i = 0; i < conn.cnt[c]; i++)
+            {
+                int node = skeleton_nodes_[conn.idx[conn.ptr[c] + i]];
+                if (node >= 0)
+                {
+                    skeleton_conn_.idx.push_back(node);
+                }
+            }
+            skeleton_conn_.cnt.push_back(static_cast<int>(skeleton_conn_.idx.size()) - skeleton_conn_.ptr.back());
+        }
+        skeleton_conn_.n1 = static_cast<int>(cells.size());
+        skeleton_conn_.n2 = skeleton_im_.n_local();
+
+        int n_interior = static_cast<int>(std::count(is_interior.cbegin(), is_interior.cend(), true));
+        Logger::instance().info("Static condensation: " + std::to_string(n_interior) + " local interior nodes, " +
+                                std::to_string(skeleton_im_.n_local()) + " local skeleton nodes\n");
+    }
+    //=============================================================================
+    const common::IndexMap &StaticCondensation::skeleton_im() const
+    {
+        return skeleton_im_;
+    }
+    //=============================================================================
+    const std::vector<int> &StaticCondensation::skeleton_nodes() const
+    {
+        return skeleton_nodes_;
+    }
+    //=============================================================================
+    int StaticCondensation::n_dof_skeleton_global() const
+    {
+        return skeleton_dof_im_.n_global() * field_.n_vars();
+    }
+    //=============================================================================
+    la::petsc::PetscMat StaticCondensation::create_mat() const
+    {
+        int n_vars = field_.n_vars();
+        auto [diag_nnz, off_diag_nnz] = la::sparsity_pattern(skeleton_conn_, skeleton_im_,
+                                                             field_.mesh().has_ghost_cells(), n_vars);
+        return la::petsc::PetscMat(diag_nnz, off_diag_nnz, n_vars);
+    }
+    //=============================================================================
+    la::petsc::PetscVec StaticCondensation::create_vec() const
+    {
+        // See la::petsc::create_vec
+        int n_vars = field_.n_vars();
+        auto ghost_nodes = skeleton_dof_im_.get_ghost_idxs();
+        std::vector<int> ghost_dof(ghost_nodes.size() * n_vars);
+        for (std::size_t i = 0; i < ghost_nodes.size(); i++)
+        {
+            for (int j = 0; j < n_vars; j++)
+            {
+                ghost_dof[i * n_vars + j] = ghost_nodes[i] * n_vars + j;
+            }
+        }
+        return la::petsc::PetscVec(skeleton_dof_im_.n_owned() * n_vars,
+                                   skeleton_dof_im_.n_global() * n_vars,
+                                   ghost_dof);
+    }
+    //=============================================================================
+    int StaticCondensation::global_skeleton_dof(int local_dof) const
+    {
+        int n_vars = field_.n_vars();
+        int node = skeleton_nodes_[local_dof / n_vars];
+        return node < 0 ? -1 : skeleton_dof_im_.local_to_global(node) * n_vars + local_dof % n_vars;
+    }
+    //=============================================================================
+    void StaticCondensation::assemble_system(fe::FEMatrixType mat_type,
+                                             fe::FEVectorType vec_type,
+                                             la::petsc::PetscMat &A,
+                                             la::petsc::PetscVec &b,
+                                             Scalar time,
+                                             Scalar diag)
+    {
+        // Time the assembly
+        common::Timer timer("Condensed system assembly");
+
+        const auto &mesh = field_.mesh();
+        auto [is_fixed, fixed_values] = fe::get_fixed_dof_mask(field_);
+        int n_vars = field_.n_vars();
+        int n_skeleton_owned = skeleton_dof_im_.n_owned();
+
+        // See fe::assemble_matrix
+        bool owner_computes = mesh.has_ghost_cells();
+        if (owner_computes)
+        {
+            MatSetOption(A.mat(), MAT_NO_OFF_PROC_ENTRIES, PETSC_TRUE);
+            VecSetOption(b.vec(), VEC_IGNORE_OFF_PROC_ENTRIES, PETSC_TRUE);
+        }
+
+        // The factors are computed by the elements' assembly, and not modified afterwards
+        factors_.clear();
+        for (const auto &elem : elems_)
+        {
+            factors_[elem.get()];
+        }
+
+        auto compute_elem_contribution = [&](const fe::FiniteElement &elem, fe::ElementContribution &c)
+        {
+            // Cell data
+            auto xpts = mesh.get_cell_xpts(elem.cell());
+            auto local_dof = field_.map_node_dof(mesh.get_cell_nodes(elem.cell()));
+            auto u = field_.get_cell_values(elem.cell());
+            int n_dof = static_cast<int>(local_dof.size());
+
+            // Integrate, and eliminate the fixed DoF (lifting)
+            auto K = elem.integrate_fe_matrix(xpts, u, mat_type, time);
+            auto f = elem.integrate_fe_vector(xpts, u, vec_type, time).entries();
+            auto &factors = factors_.at(&elem);
+            std::vector<int> interior, skeleton;
+            for (int j = 0; j < n_dof; j++)
+            {
+                if (is_fixed[local_dof[j]])
+                {
+                    for (int i = 0; i < n_dof; i++)
+                    {
+                        f[i] -= K.at(i, j) * fixed_values[local_dof[j]];
+                    }
+                }
+                else if (skeleton_nodes_[local_dof[j] / n_vars] < 0)
+                {
+                    interior.push_back(j);
+                }
+                else
+                {
+                    skeleton.push_back(j);
+                }
+            }
+            int n_i = static_cast<int>(interior.size());
+            int n_b = static_cast<int>(skeleton.size());
+
+            // K_II^-1 K_IB and K_II^-1 f_I, one column at a time
+            std::vector<Scalar> K_ii(n_i * n_i);
+            for (int i = 0; i < n_i; i++)
+            {
+                for (int j = 0; j < n_i; j++)
+                {
+                    K_ii[i * n_i + j] = K.at(interior[i], interior[j]);
+                }
+            }
+            factors.X.assign(n_i * n_b, 0.0);
+            factors.y.resize(n_i);
+            std::vector<Scalar> col(n_i);
+            for (int j = 0; j <= n_b; j++)
+            {
+                for (int i = 0; i < n_i; i++)
+                {
+                    col[i] = j < n_b ? K.at(interior[i], skeleton[j]) : f[interior[i]];
+                }
+                std::vector<Scalar> m = K_ii;
+                if (n_i > 0 && !math::solve(n_i, m.data(), col.data()))
+                {
+                    Logger::instance().error("Singular interior block in static condensation", __FILE__, __LINE__);
+                }
+                for (int i = 0; i < n_i; i++)
+                {
+                    (j < n_b ? factors.X[i * n_b + j] : factors.y[i]) = col[i];
+                }
+            }
+
+            // Schur complement, i.e. K_BB - K_BI X, and f_B - K_BI y
+            c.rows.resize(n_b);
+            c.cols.resize(n_b);
+            c.mat_values.resize(n_b * n_b);
+            c.vec_values.resize(n_b);
+            factors.interior_dof.resize(n_i);
+            factors.skeleton_dof.resize(n_b);
+            for (int i = 0; i < n_i; i++)
+            {
+                factors.interior_dof[i] = local_dof[interior[i]];
+            }
+            for (int a = 0; a < n_b; a++)
+            {
+                int dof = local_dof[skeleton[a]];
+                factors.skeleton_dof[a] = dof;
+                c.cols[a] = global_skeleton_dof(dof);
+                bool is_owned = skeleton_nodes_[dof / n_vars] < n_skeleton_owned;
+                c.rows[a] = owner_computes && !is_owned ? -1 : c.cols[a];
+                c.vec_values[a] = f[skeleton[a]];
+                for (int k = 0; k < n_i; k++)
+                {
+                    c.vec_values[a] -= K.at(skeleton[a], interior[k]) * factors.y[k];
+                }
+                for (int b = 0; b < n_b; b++)
+                {
+                    Scalar value = K.at(skeleton[a], skeleton[b]);
+                    for (int k = 0; k < n_i; k++)
+                    {
+                        value -= K.at(skeleton[a], interior[k]) * factors.X[k * n_b + b];
+                    }
+                    c.mat_values[a * n_b + b] = value;
+                }
+            }
+        };
+
+        // The owner of each fixed skeleton DoF sets the diagonal and RHS entries
+        auto add_fixed_dof_contribution = [&]()
+        {
+            for (int i = 0; i < field_.n_dof_owned(); i++)
+            {
+                int dof = global_skeleton_dof(i);
+                if (is_fixed[i] && dof >= 0)
+                {
+                    A.add_values({dof}, {dof}, {diag});
+                    b.add_values({dof}, {diag * fixed_values[i]});
+                }
+            }
+        };
+
+        fe::insert_element_contributions(elems_, mesh, &A, &b, compute_elem_contribution, add_fixed_dof_contribution);
+    }
+    //=============================================================================
+    void StaticCondensation::assemble_vector(const std::vector<std::shared_ptr<fe::FiniteElement>> &elems,
+                                             fe::FEVectorType type,
+                                             la::petsc::PetscVec &b,
+                                             Scalar time) const
+    {
+        // Time the assembly
+        common::Timer timer("Condensed vector assembly");
+
+        const auto &mesh = field_.mesh();
+        auto [is_fixed, fixed_values] = fe::get_fixed_dof_mask(field_);
+        int n_vars = field_.n_vars();
+        int n_skeleton_owned = skeleton_dof_im_.n_owned();
+
+        // See fe::assemble_vector
+        bool owner_computes = mesh.has_ghost_cells();
+        if (owner_computes)
+        {
+            VecSetOption(b.vec(), VEC_IGNORE_OFF_PROC_ENTRIES, PETSC_TRUE);
+        }
+
+        auto compute_elem_contribution = [&](const fe::FiniteElement &elem, fe::ElementContribution &c)
+        {
+            auto xpts = mesh.get_cell_xpts(elem.cell());
+            auto local_dof = field_.map_node_dof(mesh.get_cell_nodes(elem.cell()));
+            auto u = field_.get_cell_values(elem.cell());
+            c.vec_values = elem.integrate_fe_vector(xpts, u, type, time).entries();
+            c.rows.resize(local_dof.size());
+            for (std::size_t i = 0; i < local_dof.size(); i++)
+            {
+                int node = skeleton_nodes_[local_dof[i] / n_vars];
+                if (node < 0)
+                {
+                    Logger::instance().error("Vector contributions to interior DoF cannot be condensed", __FILE__, __LINE__);
+                }
+                bool is_skipped = is_fixed[local_dof[i]] || (owner_computes && node >= n_skeleton_owned);
+                c.rows[i] = is_skipped ? -1 : global_skeleton_dof(local_dof[i]);
+            }
+        };
+
+        fe::insert_element_contributions(elems, mesh, nullptr, &b, compute_elem_contribution, [] {});
+    }
+    //=============================================================================
+    std::vector<Scalar> StaticCondensation::recover(const la::petsc::PetscVec &U) const
+    {
+        // Time the recovery
+        common::Timer timer("Interior DoF recovery");
+
+        int n_vars = field_.n_vars();
+        auto U_skeleton = U.get_values();
+        auto [is_fixed, fixed_values] = fe::get_fixed_dof_mask(field_);
+
+        // Skeleton and fixed DoF
+        std::vector<Scalar> values = field_.values();
+        for (int i = 0; i < field_.n_dof_local(); i++)
+        {
+            int node = skeleton_nodes_[i / n_vars];
+            if (is_fixed[i])
+            {
+                values[i] = fixed_values[i];
+            }
+            else if (node >= 0)
+            {
+                values[i] = U_skeleton[node * n_vars + i % n_vars];
+            }
+        }
+
+        // Interior DoF, i.e. u_I = y - X u_B
+        for (const auto &elem : elems_)
+        {
+            auto it = factors_.find(elem.get());
+            if (it == factors_.end())
+            {
+                Logger::instance().error("Static condensation factors not available, call assemble_system() first", __FILE__, __LINE__);
+            }
+            const auto &factors = it->second;
+            int n_b = static_cast<int>(factors.skeleton_dof.size());
+            for (std::size_t i = 0; i < factors.interior_dof.size(); i++)
+            {
+                Scalar value = factors.y[i];
+                for (int j = 0; j < n_b; j++)
+                {
+                    value -= factors.X[i * n_b + j] * values[factors.skeleton_dof[j]];
+                }
+                values[factors.interior_dof[i]] = value;
+            }
+        }
+        return values;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,119 @@
+#pragma once
+
+#ifdef SFEM_HAS_PETSC
+
+#include "../fe/finite_element.h"
+#include "../la/petsc/petsc_utils.h"
+#include <memory>
+#include <unordered_map>
+
+namespace sfem::solvers
+{
+    /// @brief Static condensation of the DoF interior to the cells of high order meshes, e.g. the center
+    /// node of quadratic quads, or the interior nodes of cubic triangles and quads
+    /// @note The interior DoF of each element are eliminated from its matrix and vector (Schur complement)
+    /// before insertion, thus only the skeleton DoF, i.e. those of the vertex, edge and face nodes, enter the
+    /// global system. The interior values are then recovered element by element from the skeleton solution
+    /// @note The skeleton nodes have their own IndexMap and global numbering, and the skeleton system is
+    /// created by create_mat() and create_vec() rather than la::petsc::create_mat()/create_vec()
+    /// @note The fixed DoF are eliminated as by fe::assemble_constrained_system, including interior ones
+    class StaticCondensation
+    {
+    public:
+        /// @brief Create a StaticCondensation
+        /// @param elems The contributing elements, defined on the cells of the highest dimension
+        /// @param field The solution field, which holds the fixed DoF
+        StaticCondensation(const std::vector<std::shared_ptr<fe::FiniteElement>> &elems, const mesh::Field &field);
+
+        // Copy constructor (deleted)
+        StaticCondensation(const StaticCondensation &) = delete;
+
+        // Copy assignment (deleted)
+        StaticCondensation &operator=(const StaticCondensation &) = delete;
+
+        /// @brief Get the IndexMap of the skeleton nodes
+        /// @note Its local indices follow the local indices of the mesh nodes, skipping the interior ones
+        const common::IndexMap &skeleton_im() const;
+
+        /// @brief Get the skeleton node of each local mesh node (-1 for interior nodes)
+        const std::vector<int> &skeleton_nodes() const;
+
+        /// @brief Get the global number of skeleton DoF
+        int n_dof_skeleton_global() const;
+
+        /// @brief Create a PetscMat for the skeleton system
+        la::petsc::PetscMat create_mat() const;
+
+        /// @brief Create a PetscVec for the skeleton system
+        la::petsc::PetscVec create_vec() const;
+
+        /// @brief Assemble the skeleton system, i.e. the element matrices and vectors with their interior DoF
+        /// eliminated, and keep the factors required to recover the interior values
+        /// @param mat_type Element matrix type, e.g stiffness
+        /// @param vec_type Element vector type, e.g. load
+        /// @param A PetscMat where the skeleton matrix entries are assembled, created by create_mat()
+        /// @param b PetscVec where the skeleton vector entries are assembled, created by create_vec()
+        /// @param time Current solution time
+        /// @param diag Value placed on the diagonal for the fixed DoF
+        void assemble_system(fe::FEMatrixType mat_type,
+                             fe::FEVectorType vec_type,
+                             la::petsc::PetscMat &A,
+                             la::petsc::PetscVec &b,
+                             Scalar time = 0,
+                             Scalar diag = 1.0);
+
+        /// @brief Assemble further vector contributions into the skeleton vector, e.g. boundary loads
+        /// @note The elements may only involve skeleton nodes, e.g. the boundary cells. The fixed DoF are skipped
+        /// @param elems The contributing elements
+        /// @param type Element vector type, e.g. load
+        /// @param b PetscVec where the skeleton vector entries are assembled
+        /// @param time Current solution time
+        void assemble_vector(const std::vector<std::shared_ptr<fe::FiniteElement>> &elems,
+                             fe::FEVectorType type,
+                             la::petsc::PetscVec &b,
+                             Scalar time = 0) const;
+
+        /// @brief Recover the values of all local DoF of the field from the skeleton solution
+        /// @note Requires a prior assemble_system()
+        /// @param U Skeleton solution
+        /// @return The values of the local (owned and ghost) DoF of the field
+        std::vector<Scalar> recover(const la::petsc::PetscVec &U) const;
+
+    private:
+        /// @brief Factors of an element, i.e. u_I = y - X u_B
+        struct ElementFactors
+        {
+            /// @brief Local field DoF of the free interior DoF, and of the free skeleton DoF
+            std::vector<int> interior_dof;
+            std::vector<int> skeleton_dof;
+
+            /// @brief K_II^-1 K_IB, row-wise, and K_II^-1 f_I
+            std::vector<Scalar> X;
+            std::vector<Scalar> y;
+        };
+
+        /// @brief Map the local field DoF to global skeleton DoF (-1 for interior DoF)
+        int global_skeleton_dof(int local_dof) const;
+
+        /// @brief Contributing elements
+        std::vector<std::shared_ptr<fe::FiniteElement>> elems_;
+
+        /// @brief Solution field
+        mesh::Field field_;
+
+        /// @brief Skeleton node of each local node
+        std::vector<int> skeleton_nodes_;
+
+        /// @brief Skeleton node IndexMap, and its renumbered counterpart
+        common::IndexMap skeleton_im_;
+        common::IndexMap skeleton_dof_im_;
+
+        /// @brief Cell-to-skeleton node connectivity
+        mesh::Connectivity skeleton_conn_;
+
+        /// @brief Factors of each element
+        std::unordered_map<const fe::FiniteElement *, ElementFactors> factors_;
+    };
+}
+
+#endif // SFEM_HAS_PETSC
\ No newline at end of file
@@ -0,0 +1,216 @@
+#include "time_integrator.h"
+#include "../fe/utils/assembly.h"
+#include "../common/logger.h"
+#include <algorithm>
+
+namespace sfem::solvers
+{
+    //=============================================================================
+    TimeIntegrator::TimeIntegrator(const std::vector<std::shared_ptr<fe::FiniteElement>> &elems,
+                                   mesh::Field &field,
+                                   Scalar time)
+        : elems_(elems),
+          field_(field),
+          time_(time),
+          fixed_values_(la::petsc::create_vec(field.mesh(), field.n_vars())),
+          lifting_(fixed_values_.copy())
+    {
+        // The sparsity pattern is computed once, for all matrices
+        std::tie(diag_nnz_, off_diag_nnz_) = la::sparsity_pattern(field_.mesh(), field_.n_vars());
+
+        M_ = std::make_unique<la::petsc::PetscMat>(assemble_matrix(fe::FEMatrixType::mass));
+        K_ = std::make_unique<la::petsc::PetscMat>(assemble_matrix(fe::FEMatrixType::stiffness));
+
+        // The previous solution is a good initial guess for the next one
+        KSPSetInitialGuessNonzero(ksp_.ksp(), PETSC_TRUE);
+        ksp_.set_from_options();
+
+        update_fixed_dof();
+    }
+    //=============================================================================
+    Scalar TimeIntegrator::time() const
+    {
+        return time_;
+    }
+    //=============================================================================
+    int TimeIntegrator::n_steps() const
+    {
+        return n_steps_;
+    }
+    //=============================================================================
+    int TimeIntegrator::n_operator_updates() const
+    {
+        return n_operator_updates_;
+    }
+    //=============================================================================
+    mesh::Field &TimeIntegrator::field() const
+    {
+        return field_;
+    }
+    //=============================================================================
+    la::petsc::PetscKSP &TimeIntegrator::ksp()
+    {
+        return ksp_;
+    }
+    //=============================================================================
+    void TimeIntegrator::set_load_callback(LoadCallback callback)
+    {
+        load_callback_ = callback;
+    }
+    //=============================================================================
+    void TimeIntegrator::set_monitor(MonitorCallback callback)
+    {
+        monitor_ = callback;
+    }
+    //=============================================================================
+    void TimeIntegrator::update_fixed_dof()
+    {
+        // Keep only the owned fixed DoF, in global indexing
+        auto [local_dof, values] = field_.get_local_fixed_dof();
+        int n_vars = field_.n_vars();
+        auto dof_im = field_.dof_im();
+        fixed_dof_.clear();
+        fixed_dof_values_.clear();
+        for (std::size_t i = 0; i < local_dof.size(); i++)
+        {
+            if (local_dof[i] < field_.n_dof_owned())
+            {
+                int node = dof_im.local_to_global(local_dof[i] / n_vars);
+                fixed_dof_.push_back(node * n_vars + local_dof[i] % n_vars);
+                fixed_dof_values_.push_back(values[i]);
+            }
+        }
+        fixed_values_.set_all(0.0);
+        fixed_values_.insert_values(fixed_dof_, fixed_dof_values_);
+        fixed_values_.assemble();
+
+        // The constrained operator has to be re-formed
+        operator_valid_ = false;
+    }
+    //=============================================================================
+    void TimeIntegrator::solve(Scalar t_end, Scalar dt)
+    {
+        if (dt <= 0)
+        {
+            Logger::instance().error("Time step must be positive, got " + std::to_string(dt), __FILE__, __LINE__);
+        }
+
+        const Scalar tol = 1e-10 * dt;
+        while (t_end - time_ > tol)
+        {
+            advance(std::min(dt, t_end - time_));
+        }
+    }
+    //=============================================================================
+    int TimeIntegrator::advance(Scalar dt)
+    {
+        int n_iter = take_step(dt);
+        notify_monitor();
+        return n_iter;
+    }
+    //=============================================================================
+    void TimeIntegrator::save_state()
+    {
+        saved_time_ = time_;
+        saved_n_steps_ = n_steps_;
+    }
+    //=============================================================================
+    void TimeIntegrator::restore_state()
+    {
+        time_ = saved_time_;
+        n_steps_ = saved_n_steps_;
+    }
+    //=============================================================================
+    void TimeIntegrator::notify_monitor() const
+    {
+        if (monitor_)
+        {
+            monitor_(n_steps_, time_, field_);
+        }
+    }
+    //=============================================================================
+    la::petsc::PetscMat TimeIntegrator::assemble_matrix(fe::FEMatrixType type) const
+    {
+        la::petsc::PetscMat mat(diag_nnz_, off_diag_nnz_, field_.n_vars());
+        fe::assemble_matrix(elems_, field_, type, mat, time_);
+        return mat;
+    }
+    //=============================================================================
+    void TimeIntegrator::compute_load(Scalar time, la::petsc::PetscVec &F) const
+    {
+        if (load_callback_)
+        {
+            load_callback_(time, F);
+        }
+        else
+        {
+            F.set_all(0.0);
+            fe::assemble_vector(elems_, field_, fe::FEVectorType::load, F, time);
+        }
+    }
+    //=============================================================================
+    bool TimeIntegrator::update_operator(Scalar a_m, Scalar a_c, Scalar a_k)
+    {
+        std::array<Scalar, 3> coeffs = {a_m, a_c, a_k};
+        if (operator_valid_ && coeffs == coeffs_)
+        {
+            return false;
+        }
+
+        common::Timer timer("Effective operator");
+
+        // On first use, create the effective operator with the union of the
+        // non-zero patterns of M, C and K, and keep that pattern fixed from then on
+        if (!A_)
+        {
+            A_ = std::make_unique<la::petsc::PetscMat>(la::petsc::mat_copy(*K_));
+            MatAXPY(A_->mat(), 1.0, M_->mat(), DIFFERENT_NONZERO_PATTERN);
+            if (C_)
+            {
+                MatAXPY(A_->mat(), 1.0, C_->mat(), DIFFERENT_NONZERO_PATTERN);
+            }
+            MatSetOption(A_->mat(), MAT_KEEP_NONZERO_PATTERN, PETSC_TRUE);
+        }
+
+        // A = a_m M + a_c C + a_k K
+        MatZeroEntries(A_->mat());
+        MatAXPY(A_->mat(), a_k, K_->mat(), SUBSET_NONZERO_PATTERN);
+        MatAXPY(A_->mat(), a_m, M_->mat(), SUBSET_NONZERO_PATTERN);
+        if (C_)
+        {
+            MatAXPY(A_->mat(), a_c, C_->mat(), SUBSET_NONZERO_PATTERN);
+        }
+
+        // Contribution of the fixed DoF to the RHS, i.e. -A g,
+        // computed before the corresponding rows and columns are eliminated
+        la::petsc::mat_mult(*A_, fixed_values_, lifting_);
+        la::petsc::vec_scale(-1.0, lifting_);
+        MatZeroRowsColumns(A_->mat(), fixed_dof_.size(), fixed_dof_.data(), 1.0, nullptr, nullptr);
+
+        ksp_.set_operator(A_->mat());
+
+        coeffs_ = coeffs;
+        operator_valid_ = true;
+        n_operator_updates_++;
+        return true;
+    }
+    //=============================================================================
+    int TimeIntegrator::solve_step(la::petsc::PetscVec &rhs, la::petsc::PetscVec &x)
+    {
+        // Eliminate the fixed DoF from the RHS, and enforce their values
+        la::petsc::vec_axpy(1.0, lifting_, rhs);
+        rhs.insert_values(fixed_dof_, fixed_dof_values_);
+        rhs.assemble();
+        x.insert_values(fixed_dof_, fixed_dof_values_);
+        x.assemble();
+
+        return ksp_.solve(rhs.vec(), x.vec());
+    }
+    //=============================================================================
+    void TimeIntegrator::complete_step(Scalar dt, const la::petsc::PetscVec &u)
+    {
+        time_ += dt;
+        n_steps_++;
+        la::petsc::vec_to_field(u, field_);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,197 @@
+#pragma once
+
+#ifdef SFEM_HAS_PETSC
+
+#include "../fe/finite_element.h"
+#include "../la/petsc/petsc_utils.h"
+#include <functional>
+#include <array>
+#include <memory>
+
+namespace sfem::solvers
+{
+    /// @brief Base class for implicit time integrators of semi-discrete systems
+    /// of the form M u'' + C u' + K u = F(t) (or M u' + K u = F(t) for first order problems)
+    /// @note The mass, damping and stiffness matrices are assembled once and kept separate.
+    /// The effective operator a_m M + a_c C + a_k K is only re-formed (and the linear solver
+    /// reset) when its coefficients change, i.e. typically when the time step changes
+    /// @note The effective operator is constrained by elimination of the fixed DoF,
+    /// whose values are enforced at each step
+    /// @note M, C and K are kept unconstrained, since the RHS of each step involves their products
+    /// with the solution history, including its fixed DoF. Thus, the fixed DoF are eliminated from the
+    /// effective operator algebraically, but only when it is re-formed
+    class TimeIntegrator
+    {
+    public:
+        /// @brief Callback used to compute the load vector at a given time
+        using LoadCallback = std::function<void(Scalar time, la::petsc::PetscVec &F)>;
+
+        /// @brief Callback invoked after each completed time step
+        using MonitorCallback = std::function<void(int step, Scalar time, const mesh::Field &field)>;
+
+        /// @brief Create a TimeIntegrator
+        /// @param elems The contributing elements
+        /// @param field The solution field. Its current values are used as initial condition
+        /// @param time Initial time
+        TimeIntegrator(const std::vector<std::shared_ptr<fe::FiniteElement>> &elems,
+                       mesh::Field &field,
+                       Scalar time = 0);
+
+        // Copy constructor (deleted)
+        TimeIntegrator(const TimeIntegrator &) = delete;
+
+        // Copy assignment (deleted)
+        TimeIntegrator &operator=(const TimeIntegrator &) = delete;
+
+        /// @brief Destructor
+        virtual ~TimeIntegrator() = default;
+
+        /// @brief Get the current time
+        Scalar time() const;
+
+        /// @brief Get the number of completed time steps
+        int n_steps() const;
+
+        /// @brief Get the number of times the effective operator has been formed
+        int n_operator_updates() const;
+
+        /// @brief Get the solution field
+        mesh::Field &field() const;
+
+        /// @brief Get the linear solver
+        /// @note Its options prefix may be changed, followed by a call to set_from_options()
+        la::petsc::PetscKSP &ksp();
+
+        /// @brief Set the callback used to compute the load vector
+        /// @note By default, the load vector is assembled from the elements' load vectors
+        void set_load_callback(LoadCallback callback);
+
+        /// @brief Set the callback invoked after each completed time step, e.g. to write output
+        void set_monitor(MonitorCallback callback);
+
+        /// @brief Re-read the fixed DoF of the field
+        /// @note Call after the field's fixed DoF have been modified
+        void update_fixed_dof();
+
+        /// @brief Get the order of accuracy of the time integration scheme
+        virtual int order() const = 0;
+
+        /// @brief Advance the solution by a single time step, and invoke the monitor
+        /// @param dt Time step
+        /// @return Number of linear solver iterations
+        int advance(Scalar dt);
+
+        /// @brief Advance the solution by a single time step, without invoking the monitor
+        /// @note Used when the step may still be rejected, see restore_state()
+        /// @param dt Time step
+        /// @return Number of linear solver iterations
+        virtual int take_step(Scalar dt) = 0;
+
+        /// @brief Estimate the local truncation error of the last step
+        /// @param err Vector where the error estimate is stored
+        /// @return Whether an estimate is available, e.g. there is not enough history after the first step
+        virtual bool estimate_error(la::petsc::PetscVec &err) const = 0;
+
+        /// @brief Store the current state, i.e. the time and the solution history
+        virtual void save_state();
+
+        /// @brief Restore the state stored by the last call to save_state(), e.g. to reject a step
+        /// @note The field values are restored as well
+        virtual void restore_state();
+
+        /// @brief Invoke the monitor, if set, for the current step
+        void notify_monitor() const;
+
+        /// @brief Advance the solution up to a final time, using a constant time step
+        /// @note The last step is shortened, if required, to exactly reach the final time
+        /// @param t_end Final time
+        /// @param dt Time step
+        void solve(Scalar t_end, Scalar dt);
+
+    protected:
+        /// @brief Assemble a global matrix of the given type
+        la::petsc::PetscMat assemble_matrix(fe::FEMatrixType type) const;
+
+        /// @brief Compute the load vector at a given time
+        void compute_load(Scalar time, la::petsc::PetscVec &F) const;
+
+        /// @brief Form the effective operator a_m M + a_c C + a_k K and set it as the
+        /// linear solver's operator
+        /// @note Does nothing if the coefficients are unchanged since the last call
+        /// @note C may be nullptr, in which case a_c is ignored
+        /// @return Whether the operator was re-formed
+        bool update_operator(Scalar a_m, Scalar a_c, Scalar a_k);
+
+        /// @brief Solve the constrained effective system for a given RHS
+        /// @note The RHS is modified in-place, to account for the fixed DoF
+        /// @param rhs Unconstrained RHS
+        /// @param x Solution vector, also used as initial guess
+        /// @return Number of linear solver iterations
+        int solve_step(la::petsc::PetscVec &rhs, la::petsc::PetscVec &x);
+
+        /// @brief Finish a time step: update the time and the field values
+        void complete_step(Scalar dt, const la::petsc::PetscVec &u);
+
+        /// @brief Contributing elements
+        std::vector<std::shared_ptr<fe::FiniteElement>> elems_;
+
+        /// @brief Solution field
+        mesh::Field &field_;
+
+        /// @brief Current time
+        Scalar time_;
+
+        /// @brief Number of completed time steps
+        int n_steps_ = 0;
+
+        /// @brief Number of times the effective operator has been formed
+        int n_operator_updates_ = 0;
+
+        /// @brief Time and number of steps stored by save_state()
+        Scalar saved_time_ = 0;
+        int saved_n_steps_ = 0;
+
+        /// @brief Sparsity pattern, shared by all global matrices
+        std::vector<int> diag_nnz_;
+        std::vector<int> off_diag_nnz_;
+
+        /// @brief Mass matrix
+        std::unique_ptr<la::petsc::PetscMat> M_;
+
+        /// @brief Damping matrix (may be nullptr)
+        std::unique_ptr<la::petsc::PetscMat> C_;
+
+        /// @brief Stiffness matrix
+        std::unique_ptr<la::petsc::PetscMat> K_;
+
+        /// @brief Effective operator
+        std::unique_ptr<la::petsc::PetscMat> A_;
+
+        /// @brief Coefficients of the current effective operator
+        std::array<Scalar, 3> coeffs_;
+
+        /// @brief Whether the effective operator is consistent with coeffs_ and the fixed DoF
+        bool operator_valid_ = false;
+
+        /// @brief Linear solver
+        la::petsc::PetscKSP ksp_;
+
+        /// @brief Owned fixed DoF (global indexing) and their values
+        std::vector<int> fixed_dof_;
+        std::vector<Scalar> fixed_dof_values_;
+
+        /// @brief Fixed DoF values g, zero for the free DoF
+        la::petsc::PetscVec fixed_values_;
+
+        /// @brief Contribution of the fixed DoF to the RHS, i.e. -A g
+        la::petsc::PetscVec lifting_;
+
+        /// @brief User-supplied load callback
+        LoadCallback load_callback_;
+
+        /// @brief User-supplied monitor
+        MonitorCallback monitor_;
+    };
+}
+
+#endif // SFEM_HAS_PETSC